@@ -39,6 +39,8 @@ public class LazyGenericDynamicObjectPool : ModuleRules
 				"Slate",
 				"SlateCore",
 				"DeveloperSettings", 
+				"Json",
+				"JsonUtilities",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
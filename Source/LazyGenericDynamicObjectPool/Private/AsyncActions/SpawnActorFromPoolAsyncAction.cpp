@@ -0,0 +1,68 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "AsyncActions/SpawnActorFromPoolAsyncAction.h"
+#include "FunctionLibrary/LazyDynamicObjectPoolLibrary.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+
+USpawnActorFromPoolAsyncAction* USpawnActorFromPoolAsyncAction::InitializeActorFromPoolAsync(UObject* WorldContextObject,
+    const TSubclassOf<AActor> ActorClass, AActor* Owner, const float Timeout, const int32 Priority)
+{
+    USpawnActorFromPoolAsyncAction* Action = NewObject<USpawnActorFromPoolAsyncAction>();
+    Action->WorldContextObject = WorldContextObject;
+    Action->ActorClass = ActorClass;
+    Action->Owner = Owner;
+    Action->Timeout = Timeout;
+    Action->Priority = Priority;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void USpawnActorFromPoolAsyncAction::Activate()
+{
+    ULazyDynamicObjectPoolSubsystem* PoolSubsystem = ULazyDynamicObjectPoolLibrary::GetSubsystem(WorldContextObject);
+    if (!IsValid(PoolSubsystem))
+    {
+        Complete(nullptr);
+        return;
+    }
+    Subsystem = PoolSubsystem;
+
+    // The request is tied to the world context, a Blueprint destroyed while waiting never has an actor reserved for it.
+    TWeakObjectPtr<USpawnActorFromPoolAsyncAction> WeakThis(this);
+    TWeakObjectPtr<ULazyDynamicObjectPoolSubsystem> WeakSubsystem(PoolSubsystem);
+    const int32 RequestId = PoolSubsystem->InitializeActorFromPoolAsync(ActorClass, Owner, [WeakThis, WeakSubsystem](AActor* Actor)
+    {
+        if (USpawnActorFromPoolAsyncAction* This = WeakThis.Get())
+        {
+            This->Complete(Actor);
+        }
+        else if (ULazyDynamicObjectPoolSubsystem* PoolSubsystem = WeakSubsystem.Get())
+        {
+            PoolSubsystem->ReleaseReservedActor(Actor);
+        }
+    }, Timeout, Priority, WorldContextObject);
+
+    if (RequestId == INDEX_NONE)
+    {
+        Complete(nullptr);
+    }
+}
+
+void USpawnActorFromPoolAsyncAction::Complete(AActor* Actor)
+{
+    if (Actor)
+    {
+        OnSpawned.Broadcast(Actor);
+
+        // The node finishes the actor from OnSpawned. One still reserved afterwards had nobody left to finish it.
+        if (ULazyDynamicObjectPoolSubsystem* PoolSubsystem = Subsystem.Get())
+        {
+            PoolSubsystem->ReleaseReservedActor(Actor);
+        }
+    }
+    else
+    {
+        OnFailed.Broadcast(nullptr);
+    }
+    SetReadyToDestroy();
+}
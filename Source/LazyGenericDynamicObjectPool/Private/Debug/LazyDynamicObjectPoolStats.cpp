@@ -0,0 +1,14 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Debug/LazyDynamicObjectPoolStats.h"
+
+DEFINE_STAT(STAT_LazyObjectPool_Initialize);
+DEFINE_STAT(STAT_LazyObjectPool_FinishInitialize);
+DEFINE_STAT(STAT_LazyObjectPool_Return);
+DEFINE_STAT(STAT_LazyObjectPool_Grow);
+DEFINE_STAT(STAT_LazyObjectPool_Shrink);
+
+DEFINE_STAT(STAT_LazyObjectPool_Acquisitions);
+DEFINE_STAT(STAT_LazyObjectPool_Misses);
+DEFINE_STAT(STAT_LazyObjectPool_Growths);
+DEFINE_STAT(STAT_LazyObjectPool_Destroys);
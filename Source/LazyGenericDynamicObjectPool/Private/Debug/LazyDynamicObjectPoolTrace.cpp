@@ -0,0 +1,26 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Debug/LazyDynamicObjectPoolTrace.h"
+
+DEFINE_LOG_CATEGORY(LogLazyDynamicObjectPool);
+
+#if LAZYOBJECTPOOL_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(LazyObjectPoolChannel);
+
+#endif
+
+#if LAZYOBJECTPOOL_TRACE_ENABLED && COUNTERSTRACE_ENABLED
+
+FLazyObjectPoolTraceCounters::FLazyObjectPoolTraceCounters(const UClass* ObjectClass)
+    : Available(*FString::Printf(TEXT("LazyObjectPool/%s/Available"), *GetNameSafe(ObjectClass)), TraceCounterDisplayHint_None)
+    , InUse(*FString::Printf(TEXT("LazyObjectPool/%s/InUse"), *GetNameSafe(ObjectClass)), TraceCounterDisplayHint_None)
+{}
+
+void FLazyObjectPoolTraceCounters::Set(const int32 NumAvailable, const int32 NumInUse)
+{
+    Available.Set(NumAvailable);
+    InUse.Set(NumInUse);
+}
+
+#endif
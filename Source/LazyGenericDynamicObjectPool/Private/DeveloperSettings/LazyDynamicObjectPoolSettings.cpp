@@ -2,8 +2,69 @@
 
 
 #include "DeveloperSettings/LazyDynamicObjectPoolSettings.h"
+#include "GrowthPolicy/LazyDynamicObjectPoolGrowthPolicy.h"
 
 ULazyDynamicObjectPoolSettings::ULazyDynamicObjectPoolSettings(const FObjectInitializer& ObjectInitializer)
 {
 	CategoryName = TEXT("Lazy Generics");
+	GrowthPolicyClass = TSoftClassPtr<ULazyDynamicObjectPoolGrowthPolicy>(FSoftObjectPath(ULazyDynamicObjectPoolPredictiveGrowthPolicy::StaticClass()));
+}
+
+FObjectPoolClassOverride ULazyDynamicObjectPoolSettings::ResolveClassOverride(const UClass* ActorClass) const
+{
+	FObjectPoolClassOverride Resolved;
+	Resolved.ActorClass = TSoftClassPtr<UObject>(FSoftObjectPath(ActorClass));
+	Resolved.InitialPoolSize = DefaultInitialPoolSize;
+	Resolved.MaxPoolSize = MaxPoolSize;
+	Resolved.PoolGrowthFactor = PoolGrowthFactor;
+	Resolved.ShrinkThreshold = ShrinkThreshold;
+	Resolved.ParkingMode = ParkingMode;
+	Resolved.OverlapMode = OverlapMode;
+
+	// The closest class in the hierarchy that overrides a value wins for that value.
+	for (const UClass* Class = ActorClass; Class; Class = Class->GetSuperClass())
+	{
+		const FSoftObjectPath ClassPath(Class);
+		for (const FObjectPoolClassOverride& Override : ClassOverrides)
+		{
+			if (Override.ActorClass.ToSoftObjectPath() != ClassPath) continue;
+
+			if (Override.bOverrideInitialPoolSize && !Resolved.bOverrideInitialPoolSize)
+			{
+				Resolved.bOverrideInitialPoolSize = true;
+				Resolved.InitialPoolSize = Override.InitialPoolSize;
+			}
+			if (Override.bOverrideMaxPoolSize && !Resolved.bOverrideMaxPoolSize)
+			{
+				Resolved.bOverrideMaxPoolSize = true;
+				Resolved.MaxPoolSize = Override.MaxPoolSize;
+			}
+			if (Override.bOverridePoolGrowthFactor && !Resolved.bOverridePoolGrowthFactor)
+			{
+				Resolved.bOverridePoolGrowthFactor = true;
+				Resolved.PoolGrowthFactor = Override.PoolGrowthFactor;
+			}
+			if (Override.bOverrideShrinkThreshold && !Resolved.bOverrideShrinkThreshold)
+			{
+				Resolved.bOverrideShrinkThreshold = true;
+				Resolved.ShrinkThreshold = Override.ShrinkThreshold;
+			}
+			if (Override.bOverrideMinResidentActors && !Resolved.bOverrideMinResidentActors)
+			{
+				Resolved.bOverrideMinResidentActors = true;
+				Resolved.MinResidentActors = Override.MinResidentActors;
+			}
+			if (Override.bOverrideParkingMode && !Resolved.bOverrideParkingMode)
+			{
+				Resolved.bOverrideParkingMode = true;
+				Resolved.ParkingMode = Override.ParkingMode;
+			}
+			if (Override.bOverrideOverlapMode && !Resolved.bOverrideOverlapMode)
+			{
+				Resolved.bOverrideOverlapMode = true;
+				Resolved.OverlapMode = Override.OverlapMode;
+			}
+		}
+	}
+	return Resolved;
 }
@@ -3,8 +3,6 @@
 
 #include "FunctionLibrary/LazyDynamicObjectPoolLibrary.h"
 
-DEFINE_LOG_CATEGORY(LogLazyDynamicObjectPool);
-
 ULazyDynamicObjectPoolSubsystem* ULazyDynamicObjectPoolLibrary::GetSubsystem(const UObject* ContextObject)
 {
 	if(!IsValid(ContextObject))
@@ -25,10 +23,17 @@ ULazyDynamicObjectPoolSubsystem* ULazyDynamicObjectPoolLibrary::GetSubsystem(con
 	{
 		UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("GetSubsystem: ULazyDynamicObjectPoolSubsystem is not valid"));
 	}
-	else
+
+	return Subsystem;
+}
+
+ULazyDynamicObjectPoolSubsystem* ULazyDynamicObjectPoolLibrary::ResolvePoolCached(const UObject* ContextObject, const TSubclassOf<AActor> ActorClass,
+	ULazyDynamicObjectPoolSubsystem*& Subsystem, FObjectPoolId& PoolId)
+{
+	if (!IsValid(Subsystem))
 	{
-		UE_LOG(LogLazyDynamicObjectPool, Log, TEXT("GetSubsystem: Successfully retrieved ULazyDynamicObjectPoolSubsystem"));
+		Subsystem = GetSubsystem(ContextObject);
+		PoolId = IsValid(Subsystem) && ActorClass ? Subsystem->ResolvePoolId(ActorClass) : FObjectPoolId();
 	}
-
 	return Subsystem;
 }
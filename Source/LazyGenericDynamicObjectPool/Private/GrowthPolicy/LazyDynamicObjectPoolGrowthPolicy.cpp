@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "GrowthPolicy/LazyDynamicObjectPoolGrowthPolicy.h"
+#include "Containers/LazyObjectPool.h"
+
+int32 ULazyDynamicObjectPoolGrowthPolicy::GetGrowthAmount_Implementation(const FObjectPoolDemandStats& Stats, const int32 MinimumGrowth) const
+{
+    // An empty pool is filled up to its initial size, a pool that ran dry grows by the growth factor.
+    const int32 GrowthAmount = Stats.GetPoolSize() == 0
+        ? Stats.InitialSize
+        : LazyObjectPool::GetFactorGrowth(Stats.NumInUse, Stats.GrowthFactor);
+    return FMath::Max(MinimumGrowth, GrowthAmount);
+}
+
+int32 ULazyDynamicObjectPoolGrowthPolicy::GetDesiredFreeActors_Implementation(const FObjectPoolDemandStats& Stats) const
+{
+    return 0;
+}
+
+int32 ULazyDynamicObjectPoolGrowthPolicy::GetShrinkTarget_Implementation(const FObjectPoolDemandStats& Stats, const int32 DefaultTarget) const
+{
+    return DefaultTarget;
+}
+
+int32 ULazyDynamicObjectPoolPredictiveGrowthPolicy::GetGrowthAmount_Implementation(const FObjectPoolDemandStats& Stats, const int32 MinimumGrowth) const
+{
+    // Running dry means the prediction fell short, grow by at least what the next lead time is expected to need.
+    return FMath::Max(Super::GetGrowthAmount_Implementation(Stats, MinimumGrowth), MinimumGrowth + GetDesiredFreeActors(Stats));
+}
+
+int32 ULazyDynamicObjectPoolPredictiveGrowthPolicy::GetDesiredFreeActors_Implementation(const FObjectPoolDemandStats& Stats) const
+{
+    return FMath::CeilToInt(Stats.AcquisitionRate * LeadTime);
+}
+
+int32 ULazyDynamicObjectPoolPredictiveGrowthPolicy::GetShrinkTarget_Implementation(const FObjectPoolDemandStats& Stats, const int32 DefaultTarget) const
+{
+    // Shrinking right after a growth would only make the pool grow back, hold its size during the cooldown.
+    if (Stats.TimeSinceLastGrowth < ShrinkCooldown)
+    {
+        return Stats.GetPoolSize();
+    }
+
+    const int32 PeakTarget = FMath::CeilToInt(Stats.PeakInUse * PeakRetention);
+    const int32 DemandTarget = Stats.NumInUse + GetDesiredFreeActors(Stats);
+    return FMath::Max3(DefaultTarget, PeakTarget, DemandTarget);
+}
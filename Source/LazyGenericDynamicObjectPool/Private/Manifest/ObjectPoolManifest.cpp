@@ -0,0 +1,3 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Manifest/ObjectPoolManifest.h"
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Profile/ObjectPoolDemandProfile.h"
+#include "Debug/LazyDynamicObjectPoolTrace.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void FObjectPoolDemandProfile::Merge(const FObjectPoolDemandProfile& Other)
+{
+    for (const FObjectPoolClassProfile& OtherClass : Other.Classes)
+    {
+        FObjectPoolClassProfile* ClassProfile = Classes.FindByPredicate([&OtherClass](const FObjectPoolClassProfile& Entry)
+        {
+            return Entry.ActorClass == OtherClass.ActorClass;
+        });
+
+        if (!ClassProfile)
+        {
+            Classes.Add(OtherClass);
+            continue;
+        }
+
+        ClassProfile->PeakInUse = FMath::Max(ClassProfile->PeakInUse, OtherClass.PeakInUse);
+        ClassProfile->GrowthEvents += OtherClass.GrowthEvents;
+        ClassProfile->Misses += OtherClass.Misses;
+        ClassProfile->NumSessions += OtherClass.NumSessions;
+    }
+}
+
+const FObjectPoolClassProfile* FObjectPoolDemandProfile::FindClass(const FSoftClassPath& ActorClass) const
+{
+    return Classes.FindByPredicate([&ActorClass](const FObjectPoolClassProfile& Entry)
+    {
+        return Entry.ActorClass == ActorClass;
+    });
+}
+
+bool FObjectPoolDemandProfile::LoadFromFile(const FString& FilePath)
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *FilePath)) return false;
+
+    FObjectPoolDemandProfile LoadedProfile;
+    if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &LoadedProfile))
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Failed to parse pool demand profile %s"), *FilePath);
+        return false;
+    }
+
+    if (LoadedProfile.Version != CurrentVersion)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Ignored pool demand profile %s with version %d, expected %d"), *FilePath, LoadedProfile.Version, CurrentVersion);
+        return false;
+    }
+
+    *this = MoveTemp(LoadedProfile);
+    return true;
+}
+
+bool FObjectPoolDemandProfile::SaveToFile(const FString& FilePath) const
+{
+    FString Json;
+    if (!FJsonObjectConverter::UStructToJsonObjectString(*this, Json)) return false;
+
+    return FFileHelper::SaveStringToFile(Json, *FilePath);
+}
+
+FString FObjectPoolDemandProfile::GetSavedFilePath(const FString& MapName)
+{
+    return FPaths::ProjectSavedDir() / TEXT("ObjectPoolProfiles") / MapName + TEXT(".json");
+}
+
+FString FObjectPoolDemandProfile::GetShippedFilePath(const FString& MapName)
+{
+    return FPaths::ProjectContentDir() / TEXT("ObjectPoolProfiles") / MapName + TEXT(".json");
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Subsystems/LazyDynamicObjectPoolAsyncAccess.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+
+bool FObjectPoolAsyncAccess::TryClaimActor(const FTransform& Transform, TFunction<void(AActor*)>&& OnAcquired) const
+{
+    if (!IsValid()) return false;
+
+    // A claim only goes through while the pool has headroom for it, so the game thread never has to turn one down for size.
+    int32 NumClaimed = Counters->NumClaimed.load(std::memory_order_relaxed);
+    do
+    {
+        if (NumClaimed >= Counters->Headroom.load(std::memory_order_relaxed)) return false;
+    }
+    while (!Counters->NumClaimed.compare_exchange_weak(NumClaimed, NumClaimed + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    Queues->Acquires.Enqueue({ PoolIndex, Transform, MoveTemp(OnAcquired) });
+    return true;
+}
+
+void FObjectPoolAsyncAccess::EnqueueReturn(AActor* Actor) const
+{
+    if (Queues.IsValid() && Actor)
+    {
+        Queues->Returns.Enqueue(Actor);
+    }
+}
+
+void FObjectPoolAsyncAccess::EnqueueReturn(const FPooledActorHandle& Handle) const
+{
+    if (Queues.IsValid() && Handle.IsSet())
+    {
+        Queues->HandleReturns.Enqueue(Handle);
+    }
+}
+
+void FLazyObjectPoolAsyncTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (IsValid(Subsystem))
+    {
+        Subsystem->SettleAsyncRequests();
+    }
+}
+
+FString FLazyObjectPoolAsyncTickFunction::DiagnosticMessage()
+{
+    return TEXT("FLazyObjectPoolAsyncTickFunction");
+}
@@ -1,8 +1,22 @@
 // Copyright (C) 2024 Job Omondiale - All Rights Reserved
 
 #include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+#include "Debug/LazyDynamicObjectPoolStats.h"
 #include "DeveloperSettings/LazyDynamicObjectPoolSettings.h"
+#include "GrowthPolicy/LazyDynamicObjectPoolGrowthPolicy.h"
+#include "Manifest/ObjectPoolManifest.h"
 #include "Interface/PoolableActorInterface.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/StableSort.h"
+#include "Misc/PackageName.h"
 
 ULazyDynamicObjectPoolSubsystem::ULazyDynamicObjectPoolSubsystem()
 {}
@@ -10,257 +24,2608 @@ ULazyDynamicObjectPoolSubsystem::ULazyDynamicObjectPoolSubsystem()
 void ULazyDynamicObjectPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
-    
+
     Settings = GetMutableDefault<ULazyDynamicObjectPoolSettings>();
     check(Settings);
 
-    if (Settings->bEnableAutoShrink && IsValid(GetWorld()))
+    const UClass* GrowthPolicyClass = Settings->GrowthPolicyClass.LoadSynchronous();
+    GrowthPolicy = NewObject<ULazyDynamicObjectPoolGrowthPolicy>(this, GrowthPolicyClass ? GrowthPolicyClass : ULazyDynamicObjectPoolGrowthPolicy::StaticClass());
+    AsyncQueues = MakeShared<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe>();
+
+    // Still capped by LAZYOBJECTPOOL_LOG_COMPILE_VERBOSITY, shipping builds keep only warnings.
+    if (Settings->bEnableDetailedLogging)
+    {
+        LogLazyDynamicObjectPool.SetVerbosity(ELogVerbosity::Verbose);
+    }
+
+    const UWorld* World = GetWorld();
+    if (IsValid(World) && World->IsGameWorld())
+    {
+        ProfileMapName = FPackageName::GetShortName(UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()));
+
+        // A profile recorded on this machine wins over the one shipped with the project.
+        if (Settings->bUseDemandProfiles
+            && !DemandProfile.LoadFromFile(FObjectPoolDemandProfile::GetSavedFilePath(ProfileMapName)))
+        {
+            DemandProfile.LoadFromFile(FObjectPoolDemandProfile::GetShippedFilePath(ProfileMapName));
+        }
+    }
+
+    if (Settings->bEnableAutoShrink && IsValid(GetWorld()))
+    {
+        NextShrinkTime = Settings->AutoShrinkInterval;
+        GetWorld()->GetTimerManager().SetTimer(ShrinkTimeProgressTimerHandle, this, &ULazyDynamicObjectPoolSubsystem::CalculateNextShrinkTime, 1, true);
+        GetWorld()->GetTimerManager().SetTimer(AutoShrinkTimerHandle, this, &ULazyDynamicObjectPoolSubsystem::PerformAutoShrink, Settings->AutoShrinkInterval, true);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::Deinitialize()
+{
+    if (Settings->bRecordDemandProfiles && !ProfileMapName.IsEmpty())
+    {
+        SaveDemandProfile();
+    }
+
+    GetWorld()->GetTimerManager().ClearTimer(AutoShrinkTimerHandle);
+    GetWorld()->GetTimerManager().ClearTimer(ShrinkTimeProgressTimerHandle);
+
+    AbandonAsyncAcquires();
+
+    // Async access handles can outlive the subsystem, closing their headroom turns any later claim down on the spot.
+    if (AsyncTickFunction.IsTickFunctionRegistered())
+    {
+        AsyncTickFunction.UnRegisterTickFunction();
+    }
+    for (FObjectPool& Pool : ObjectPools)
+    {
+        if (Pool.AsyncCounters.IsValid()) Pool.AsyncCounters->Headroom.store(0, std::memory_order_relaxed);
+    }
+
+    // Pooled components and projectile renderers have no owning actor to unregister them when the world is torn down.
+    for (FProjectileRecords& Records : ProjectileRecords)
+    {
+        if (IsValid(Records.Renderer)) Records.Renderer->DestroyComponent();
+    }
+    for (FDehydratedActors& Dehydrated : DehydratedActors)
+    {
+        if (IsValid(Dehydrated.Renderer)) Dehydrated.Renderer->DestroyComponent();
+    }
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
+    {
+        if (ObjectPools[PoolIndex].Kind != EObjectPoolKind::Component) continue;
+
+        for (int32 SlotIndex = 0; SlotIndex < ObjectPools[PoolIndex].Slots.GetMaxIndex(); ++SlotIndex)
+        {
+            if (ObjectPools[PoolIndex].Slots.GetState(SlotIndex) != ELazyPoolSlotState::Empty)
+            {
+                DestroyPooledObject(PoolIndex, SlotIndex);
+            }
+        }
+    }
+    Super::Deinitialize();
+}
+
+void ULazyDynamicObjectPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    AsyncTickFunction.Subsystem = this;
+    AsyncTickFunction.bCanEverTick = true;
+    AsyncTickFunction.TickGroup = Settings->AsyncSettleTickGroup;
+    AsyncTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+    ApplyManifest(LoadManifestForWorld(InWorld));
+    if (Settings->bEnableDehydration)
+    {
+        for (const FObjectPoolDehydrationClass& DehydrationClass : Settings->DehydrationClasses)
+        {
+            RegisterDehydrationClass(DehydrationClass);
+        }
+    }
+    if (Settings->bUseDemandProfiles)
+    {
+        PrewarmFromDemandProfile();
+    }
+}
+
+const UObjectPoolManifest* ULazyDynamicObjectPoolSubsystem::LoadManifestForWorld(const UWorld& InWorld) const
+{
+    // Worlds played in the editor live in a renamed package, the map entries refer to the original one.
+    const FString MapPackageName = UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+    for (const TPair<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UObjectPoolManifest>>& MapManifest : Settings->MapManifests)
+    {
+        if (MapManifest.Key.ToSoftObjectPath().GetLongPackageName() == MapPackageName)
+        {
+            return MapManifest.Value.LoadSynchronous();
+        }
+    }
+    return Settings->DefaultManifest.LoadSynchronous();
+}
+
+void ULazyDynamicObjectPoolSubsystem::ApplyManifest(const UObjectPoolManifest* Manifest)
+{
+    if (!IsValid(Manifest) || Manifest->Entries.IsEmpty()) return;
+
+    TArray<FObjectPoolManifestEntry> Entries = Manifest->Entries;
+    Algo::StableSort(Entries, [](const FObjectPoolManifestEntry& A, const FObjectPoolManifestEntry& B)
+    {
+        return A.Priority > B.Priority;
+    });
+
+    const bool bBlocking = Settings->bBlockingPrewarm || !Settings->bEnableBudgetedGrowth;
+    for (const FObjectPoolManifestEntry& Entry : Entries)
+    {
+        const TSubclassOf<AActor> ActorClass = Entry.ActorClass.LoadSynchronous();
+        if (!ActorClass)
+        {
+            UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Failed to load %s from pool manifest %s"), *Entry.ActorClass.ToString(), *Manifest->GetName());
+            continue;
+        }
+
+        // A recorded profile can only raise the size the manifest asks for.
+        const int32 PoolIndex = FindOrAddPoolIndex(ActorClass);
+        FObjectPool& Pool = ObjectPools[PoolIndex];
+        Pool.InitialSize = FMath::Max(Entry.InitialSize, Pool.InitialSize);
+        if (Entry.MaxSize > 0) Pool.MaxSize = Entry.MaxSize;
+        Pool.Priority = Entry.Priority;
+        PrewarmPool(PoolIndex, Pool.InitialSize, bBlocking);
+    }
+
+    UpdatePrewarmProgress();
+}
+
+void ULazyDynamicObjectPoolSubsystem::PrewarmFromDemandProfile()
+{
+    const bool bBlocking = Settings->bBlockingPrewarm || !Settings->bEnableBudgetedGrowth;
+    for (const FObjectPoolClassProfile& ClassProfile : DemandProfile.Classes)
+    {
+        const UClass* ObjectClass = ClassProfile.ActorClass.TryLoadClass<UObject>();
+        if (!ObjectClass) continue;
+
+        // Pools listed in the manifest were already prewarmed with the profile taken into account.
+        const int32 PoolIndex = FindOrAddPoolIndex(ObjectClass);
+        if (ObjectPools[PoolIndex].Num() + ObjectPools[PoolIndex].PendingGrowth > 0) continue;
+
+        PrewarmPool(PoolIndex, GetInitialSize(PoolIndex), bBlocking);
+    }
+
+    UpdatePrewarmProgress();
+}
+
+void ULazyDynamicObjectPoolSubsystem::PrewarmPool(const int32 PoolIndex, const int32 PoolSize, const bool bBlocking)
+{
+    if (PoolSize <= 0) return;
+
+    if (PrewarmTargets.IsEmpty()) PrewarmProgress = 0.0f;
+    PrewarmTargets.Add({ PoolIndex, PoolSize });
+
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    const UClass* ObjectClass = Pool.ObjectClass;
+    const int32 MissingActors = PoolSize - (Pool.Num() + Pool.PendingGrowth);
+    if (MissingActors <= 0) return;
+
+    Pool.Demand.LegacyFreeActors += MissingActors;
+    if (bBlocking)
+    {
+        GrowActorPool(PoolIndex, MissingActors);
+    }
+    else
+    {
+        RequestPoolGrowth(PoolIndex, MissingActors);
+    }
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Prewarming pool for %s with %d objects"), *ObjectClass->GetName(), MissingActors);
+}
+
+void ULazyDynamicObjectPoolSubsystem::SaveDemandProfile() const
+{
+    FObjectPoolDemandProfile SessionProfile;
+    for (const FObjectPool& Pool : ObjectPools)
+    {
+        if (!Pool.ObjectClass || Pool.Session.PeakInUse == 0) continue;
+
+        FObjectPoolClassProfile& ClassProfile = SessionProfile.Classes.AddDefaulted_GetRef();
+        ClassProfile.ActorClass = FSoftClassPath(Pool.ObjectClass);
+        ClassProfile.PeakInUse = Pool.Session.PeakInUse;
+        ClassProfile.GrowthEvents = Pool.Session.GrowthEvents;
+        ClassProfile.Misses = Pool.Session.Misses;
+        ClassProfile.NumSessions = 1;
+    }
+    if (SessionProfile.Classes.IsEmpty()) return;
+
+    // Merge with what earlier sessions recorded rather than with the profile in use, which may be the shipped one.
+    const FString FilePath = FObjectPoolDemandProfile::GetSavedFilePath(ProfileMapName);
+    FObjectPoolDemandProfile RecordedProfile;
+    RecordedProfile.LoadFromFile(FilePath);
+    RecordedProfile.Merge(SessionProfile);
+
+    if (!RecordedProfile.SaveToFile(FilePath))
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Failed to save pool demand profile %s"), *FilePath);
+    }
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetProfiledInitialSize(const UClass* ClassType) const
+{
+    if (!Settings->bUseDemandProfiles) return 0;
+
+    const FObjectPoolClassProfile* ClassProfile = DemandProfile.FindClass(FSoftClassPath(ClassType));
+    return ClassProfile ? FMath::CeilToInt(ClassProfile->PeakInUse * Settings->ProfileHeadroom) : 0;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetInitialSize(const int32 PoolIndex) const
+{
+    const int32 InitialSize = ObjectPools[PoolIndex].InitialSize;
+    return InitialSize > 0 ? InitialSize : Settings->DefaultInitialPoolSize;
+}
+
+void ULazyDynamicObjectPoolSubsystem::UpdatePrewarmProgress()
+{
+    if (PrewarmTargets.IsEmpty()) return;
+
+    int32 SpawnedActors = 0;
+    int32 TotalActors = 0;
+    bool bComplete = true;
+    for (const FPrewarmTarget& Target : PrewarmTargets)
+    {
+        const FObjectPool& Pool = ObjectPools[Target.PoolIndex];
+        SpawnedActors += FMath::Min(Pool.Num(), Target.Size);
+        TotalActors += Target.Size;
+
+        // A pool can stop short of its target at its size limit or when spawning fails, it is done once nothing is queued.
+        bComplete &= Pool.Num() >= Target.Size || Pool.PendingGrowth == 0;
+    }
+
+    const float NewProgress = bComplete ? 1.0f : static_cast<float>(SpawnedActors) / static_cast<float>(FMath::Max(TotalActors, 1));
+    if (bComplete)
+    {
+        PrewarmTargets.Reset();
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Prewarm complete with %d of %d actors"), SpawnedActors, TotalActors);
+    }
+
+    if (NewProgress != PrewarmProgress)
+    {
+        PrewarmProgress = NewProgress;
+        OnPrewarmProgress.Broadcast(PrewarmProgress);
+    }
+}
+
+bool ULazyDynamicObjectPoolSubsystem::IsPrewarmComplete() const
+{
+    return PrewarmTargets.IsEmpty();
+}
+
+float ULazyDynamicObjectPoolSubsystem::GetPrewarmProgress() const
+{
+    return PrewarmProgress;
+}
+
+void ULazyDynamicObjectPoolSubsystem::Tick(float DeltaTime)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(Tick);
+
+    Super::Tick(DeltaTime);
+
+    ProcessPendingOverlapUpdates();
+    ProcessProjectileRecords(DeltaTime);
+    ProcessDehydration();
+    UpdatePoolDemand(DeltaTime);
+    if (Settings->bEnableBudgetedGrowth)
+    {
+        ProcessPendingGrowth();
+    }
+    ProcessAsyncAcquires();
+    ProcessPendingShrink();
+    ProcessIdleTiers();
+    EnforceMemoryBudget();
+    UpdatePrewarmProgress();
+    UpdateTraceCounters();
+}
+
+TStatId ULazyDynamicObjectPoolSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ULazyDynamicObjectPoolSubsystem, STATGROUP_LazyObjectPool);
+}
+
+void ULazyDynamicObjectPoolSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    Super::AddReferencedObjects(InThis, Collector);
+
+    // Actors are kept alive by their level, pooled components and objects have nothing but the pool holding on to them.
+    ULazyDynamicObjectPoolSubsystem* This = CastChecked<ULazyDynamicObjectPoolSubsystem>(InThis);
+    for (FObjectPool& Pool : This->ObjectPools)
+    {
+        if (Pool.Kind == EObjectPoolKind::Actor) continue;
+
+        for (int32 SlotIndex = 0; SlotIndex < Pool.Slots.GetMaxIndex(); ++SlotIndex)
+        {
+            if (Pool.Slots[SlotIndex].Object) Collector.AddReferencedObject(Pool.Slots[SlotIndex].Object, This);
+        }
+    }
+
+    for (FProjectileRecords& Records : This->ProjectileRecords)
+    {
+        Collector.AddReferencedObject(Records.Renderer, This);
+        Collector.AddReferencedObject(Records.Config.Mesh, This);
+    }
+    for (FDehydratedActors& Dehydrated : This->DehydratedActors)
+    {
+        Collector.AddReferencedObject(Dehydrated.Renderer, This);
+    }
+}
+
+bool ULazyDynamicObjectPoolSubsystem::CreatePool(TSubclassOf<AActor> ActorClass, int32 InitialSize)
+{
+    if (!ActorClass || GetPoolSize(ActorClass) + GetPendingPoolGrowth(ActorClass) > 0) return false;
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ActorClass);
+    const int32 PoolSize = (InitialSize > 0) ? InitialSize : GetInitialSize(PoolIndex);
+    ObjectPools[PoolIndex].Demand.LegacyFreeActors += PoolSize;
+    if (Settings->bEnableBudgetedGrowth)
+    {
+        RequestPoolGrowth(PoolIndex, PoolSize);
+    }
+    else
+    {
+        GrowActorPool(PoolIndex, PoolSize);
+    }
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Created actor pool for %s with size %d"), *ActorClass->GetName(), PoolSize);
+    return true;
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::InitializeActorFromPool(const TSubclassOf<AActor> ActorClass, AActor* NewOwner)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(InitializeActorFromPool);
+
+    if (!ActorClass) return nullptr;
+
+    return InitializeActorFromPoolId(FObjectPoolId(FindOrAddPoolIndex(ActorClass)), NewOwner);
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::InitializeActorFromPoolId(const FObjectPoolId PoolId, AActor* NewOwner)
+{
+    if (!IsActorPoolId(PoolId)) return nullptr;
+
+    const int32 SlotIndex = ReserveSlot(PoolId.GetIndex(), NewOwner);
+    return SlotIndex != INDEX_NONE ? ObjectPools[PoolId.GetIndex()].Slots[SlotIndex].GetActor() : nullptr;
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::AcquireActorFromPoolId(const FObjectPoolId PoolId, const FTransform& NewTransform, AActor* NewOwner)
+{
+    if (!IsActorPoolId(PoolId)) return nullptr;
+
+    const int32 SlotIndex = ReserveSlot(PoolId.GetIndex(), NewOwner);
+    if (SlotIndex == INDEX_NONE) return nullptr;
+
+    ActivateSlot({ PoolId.GetIndex(), SlotIndex }, NewTransform, false, nullptr, ETeleportType::None);
+    return ObjectPools[PoolId.GetIndex()].Slots[SlotIndex].GetActor();
+}
+
+bool ULazyDynamicObjectPoolSubsystem::IsActorPoolId(const FObjectPoolId PoolId) const
+{
+    if (!ObjectPools.IsValidIndex(PoolId.GetIndex())) return false;
+
+    // Component and object pools share the id space, their slots must never be handed out as actors.
+    if (ObjectPools[PoolId.GetIndex()].Kind != EObjectPoolKind::Actor)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Error, TEXT("Attempted to acquire an actor from the pool of %s, which does not pool actors"),
+            *GetNameSafe(ObjectPools[PoolId.GetIndex()].ObjectClass));
+        return false;
+    }
+    return true;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::AcquireActorFromPoolAsync(const TSubclassOf<AActor> ActorClass, const FTransform& NewTransform,
+    TFunction<void(AActor*)>&& OnCompleted, const float Timeout, const int32 Priority, AActor* NewOwner, const UObject* Requester)
+{
+    FPendingAsyncAcquire Request;
+    Request.Priority = Priority;
+    Request.Transform = NewTransform;
+    Request.Owner = NewOwner;
+    Request.OnCompleted = MoveTemp(OnCompleted);
+    Request.Requester = Requester;
+    return QueueAsyncAcquire(ActorClass, MoveTemp(Request), Timeout);
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::InitializeActorFromPoolAsync(const TSubclassOf<AActor> ActorClass, AActor* NewOwner,
+    TFunction<void(AActor*)>&& OnCompleted, const float Timeout, const int32 Priority, const UObject* Requester)
+{
+    FPendingAsyncAcquire Request;
+    Request.Priority = Priority;
+    Request.bActivate = false;
+    Request.Owner = NewOwner;
+    Request.OnCompleted = MoveTemp(OnCompleted);
+    Request.Requester = Requester;
+    return QueueAsyncAcquire(ActorClass, MoveTemp(Request), Timeout);
+}
+
+FPooledActorFuture ULazyDynamicObjectPoolSubsystem::AcquireActorFromPoolFuture(const TSubclassOf<AActor> ActorClass, const FTransform& NewTransform,
+    const float Timeout, const int32 Priority, AActor* NewOwner)
+{
+    TSharedRef<TPromise<AActor*>> Promise = MakeShared<TPromise<AActor*>>();
+    FPooledActorFuture Result;
+    Result.Future = Promise->GetFuture();
+    Result.RequestId = AcquireActorFromPoolAsync(ActorClass, NewTransform, [Promise](AActor* Actor) { Promise->SetValue(Actor); }, Timeout, Priority, NewOwner);
+    if (Result.RequestId == INDEX_NONE)
+    {
+        Promise->SetValue(nullptr);
+    }
+    return Result;
+}
+
+bool ULazyDynamicObjectPoolSubsystem::ReleaseReservedActor(AActor* Actor)
+{
+    const FPoolSlotRef* SlotRef = IsValid(Actor) ? PooledObjectSlots.Find(Actor) : nullptr;
+    if (!SlotRef || ObjectPools[SlotRef->PoolIndex].Slots.GetState(SlotRef->SlotIndex) != ELazyPoolSlotState::Reserved) return false;
+
+    FObjectPool& Pool = ObjectPools[SlotRef->PoolIndex];
+    Pool.Slots.SetState(SlotRef->SlotIndex, ELazyPoolSlotState::Available);
+    Pool.Slots[SlotRef->SlotIndex].LastReturnedTime = GetWorld()->GetTimeSeconds();
+    Pool.Demand.LegacyFreeActors++;
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Released reserved actor %s"), *Actor->GetName());
+    return true;
+}
+
+bool ULazyDynamicObjectPoolSubsystem::CancelAsyncAcquire(const int32 RequestId)
+{
+    const int32 RequestIndex = PendingAsyncAcquires.IndexOfByPredicate([RequestId](const FPendingAsyncAcquire& Request) { return Request.RequestId == RequestId; });
+    if (RequestIndex == INDEX_NONE) return false;
+
+    // Completed with null rather than dropped, a future waiting on it would otherwise never be set.
+    TFunction<void(AActor*)> OnCompleted = MoveTemp(PendingAsyncAcquires[RequestIndex].OnCompleted);
+    PendingAsyncAcquires.RemoveAt(RequestIndex);
+    if (OnCompleted)
+    {
+        OnCompleted(nullptr);
+    }
+    return true;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::QueueAsyncAcquire(const TSubclassOf<AActor> ActorClass, FPendingAsyncAcquire&& Request, const float Timeout)
+{
+    const UWorld* World = GetWorld();
+    if (!ActorClass || !IsValid(World)) return INDEX_NONE;
+
+    Request.RequestId = NextAsyncAcquireId++;
+    Request.PoolIndex = FindOrAddPoolIndex(ActorClass);
+    Request.Deadline = Timeout > 0.0f ? World->GetTimeSeconds() + Timeout : 0.0;
+
+    // Behind every request of the same or a higher priority.
+    const int32 InsertIndex = Algo::UpperBoundBy(PendingAsyncAcquires, -Request.Priority, [](const FPendingAsyncAcquire& Pending) { return -Pending.Priority; });
+    PendingAsyncAcquires.Insert(MoveTemp(Request), InsertIndex);
+    return PendingAsyncAcquires[InsertIndex].RequestId;
+}
+
+void ULazyDynamicObjectPoolSubsystem::AbandonAsyncAcquires()
+{
+    // Waiters complete with null so futures are never left hanging. A waiter may queue a new request, which stays queued.
+    TArray<FPendingAsyncAcquire> AbandonedAcquires = MoveTemp(PendingAsyncAcquires);
+    PendingAsyncAcquires.Reset();
+    for (FPendingAsyncAcquire& Request : AbandonedAcquires)
+    {
+        if (Request.OnCompleted) Request.OnCompleted(nullptr);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::ProcessAsyncAcquires()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessAsyncAcquires);
+
+    if (PendingAsyncAcquires.IsEmpty()) return;
+
+    // Requests are picked before any is completed, completing one runs gameplay that may queue or cancel others.
+    const double Now = GetWorld()->GetTimeSeconds();
+    TArray<int32> ReadyIds;
+    TMap<int32, int32> ServableByPool;
+    TMap<int32, int32> WaitingByPool;
+    for (const FPendingAsyncAcquire& Request : PendingAsyncAcquires)
+    {
+        // Abandoned, completed with null without taking an actor.
+        if (Request.Requester.IsStale())
+        {
+            ReadyIds.Add(Request.RequestId);
+            continue;
+        }
+
+        int32* Servable = ServableByPool.Find(Request.PoolIndex);
+        if (!Servable)
+        {
+            // Without a growth budget the acquisition spawns what it needs right away, with one the pool grows over the next frames.
+            const FObjectPool& Pool = ObjectPools[Request.PoolIndex];
+            const bool bCanGrow = Pool.MaxSize <= 0 || Pool.Num() < Pool.MaxSize;
+            Servable = &ServableByPool.Add(Request.PoolIndex, bCanGrow && !Settings->bEnableBudgetedGrowth ? MAX_int32 : Pool.Slots.GetAvailable().Num);
+        }
+
+        if (*Servable > 0)
+        {
+            --*Servable;
+            ReadyIds.Add(Request.RequestId);
+        }
+        else if (Request.Deadline > 0.0 && Now >= Request.Deadline)
+        {
+            ReadyIds.Add(Request.RequestId);
+        }
+        else
+        {
+            WaitingByPool.FindOrAdd(Request.PoolIndex)++;
+        }
+    }
+
+    if (Settings->bEnableBudgetedGrowth)
+    {
+        for (const TPair<int32, int32>& Waiting : WaitingByPool)
+        {
+            if (ObjectPools[Waiting.Key].PendingGrowth == 0)
+            {
+                RequestPoolGrowth(Waiting.Key, GetGrowthAmount(Waiting.Key, Waiting.Value));
+            }
+        }
+    }
+
+    auto FindRequest = [this](const int32 RequestId)
+    {
+        return PendingAsyncAcquires.IndexOfByPredicate([RequestId](const FPendingAsyncAcquire& Request) { return Request.RequestId == RequestId; });
+    };
+
+    for (const int32 RequestId : ReadyIds)
+    {
+        // Cancelled by an earlier completion.
+        int32 RequestIndex = FindRequest(RequestId);
+        if (RequestIndex == INDEX_NONE) continue;
+
+        AActor* Actor = nullptr;
+        const FPendingAsyncAcquire& Request = PendingAsyncAcquires[RequestIndex];
+        if ((Request.Deadline <= 0.0 || Now < Request.Deadline) && !Request.Requester.IsStale())
+        {
+            const bool bActivate = Request.bActivate;
+            const FObjectPoolId PoolId(Request.PoolIndex);
+            const FTransform Transform = Request.Transform;
+            AActor* Owner = Request.Owner.Get();
+            Actor = bActivate ? AcquireActorFromPoolId(PoolId, Transform, Owner) : InitializeActorFromPoolId(PoolId, Owner);
+
+            // Stays queued when the pool failed to produce an actor after all.
+            if (!Actor) continue;
+
+            // Activation runs gameplay, the request may have moved or been cancelled in the meantime.
+            RequestIndex = FindRequest(RequestId);
+            if (RequestIndex == INDEX_NONE)
+            {
+                // A reserved actor was never activated, it goes back without being deactivated.
+                if (bActivate) ReturnActorToPool(Actor);
+                else ReleaseReservedActor(Actor);
+                continue;
+            }
+        }
+
+        TFunction<void(AActor*)> OnCompleted = MoveTemp(PendingAsyncAcquires[RequestIndex].OnCompleted);
+        PendingAsyncAcquires.RemoveAt(RequestIndex);
+        if (OnCompleted)
+        {
+            OnCompleted(Actor);
+        }
+    }
+}
+
+FObjectPoolAsyncAccess ULazyDynamicObjectPoolSubsystem::GetAsyncAccess(const FObjectPoolId PoolId)
+{
+    check(IsInGameThread());
+
+    if (!ObjectPools.IsValidIndex(PoolId.GetIndex()) || ObjectPools[PoolId.GetIndex()].Kind != EObjectPoolKind::Actor) return FObjectPoolAsyncAccess();
+
+    FObjectPool& Pool = ObjectPools[PoolId.GetIndex()];
+    if (!Pool.AsyncCounters.IsValid())
+    {
+        Pool.AsyncCounters = MakeShared<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe>();
+        PublishAsyncHeadroom(PoolId.GetIndex());
+    }
+
+    return FObjectPoolAsyncAccess(PoolId.GetIndex(), Pool.AsyncCounters, AsyncQueues);
+}
+
+void ULazyDynamicObjectPoolSubsystem::PublishAsyncHeadroom(const int32 PoolIndex)
+{
+    const FObjectPool& Pool = ObjectPools[PoolIndex];
+    if (!Pool.AsyncCounters.IsValid()) return;
+
+    // Claims are counted against what the pool may still hand out, an unlimited pool never turns one down.
+    const int32 Headroom = Pool.MaxSize > 0 ? FMath::Max(0, Pool.MaxSize - Pool.Slots.GetNumAcquired()) : MAX_int32;
+    Pool.AsyncCounters->Headroom.store(Headroom, std::memory_order_relaxed);
+}
+
+void ULazyDynamicObjectPoolSubsystem::SettleAsyncRequests()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(SettleAsyncRequests);
+
+    // Returns first, so claims settled in the same frame can reuse the returned actors.
+    TArray<AActor*> Returned;
+    TWeakObjectPtr<AActor> ReturnedActor;
+    while (AsyncQueues->Returns.Dequeue(ReturnedActor))
+    {
+        if (AActor* Actor = ReturnedActor.Get()) Returned.Add(Actor);
+    }
+    FPooledActorHandle ReturnedHandle;
+    while (AsyncQueues->HandleReturns.Dequeue(ReturnedHandle))
+    {
+        if (AActor* Actor = GetActorFromHandle(ReturnedHandle)) Returned.Add(Actor);
+    }
+    if (!Returned.IsEmpty())
+    {
+        ReturnActorsToPool(Returned);
+    }
+
+    // Callbacks may claim again, those claims are only drained next frame.
+    TArray<FLazyObjectPoolAsyncQueues::FAcquireRequest> Acquires;
+    FLazyObjectPoolAsyncQueues::FAcquireRequest Request;
+    while (AsyncQueues->Acquires.Dequeue(Request))
+    {
+        Acquires.Add(MoveTemp(Request));
+    }
+    for (FLazyObjectPoolAsyncQueues::FAcquireRequest& Acquire : Acquires)
+    {
+        AActor* Actor = AcquireActorFromPoolId(FObjectPoolId(Acquire.PoolIndex), Acquire.Transform);
+
+        // The claim is settled before the callback runs so it can already claim against the freed headroom.
+        ObjectPools[Acquire.PoolIndex].AsyncCounters->NumClaimed.fetch_sub(1, std::memory_order_acq_rel);
+        PublishAsyncHeadroom(Acquire.PoolIndex);
+        if (Acquire.OnAcquired)
+        {
+            Acquire.OnAcquired(Actor);
+        }
+    }
+
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
+    {
+        PublishAsyncHeadroom(PoolIndex);
+    }
+}
+
+FObjectPoolId ULazyDynamicObjectPoolSubsystem::ResolvePoolId(const TSubclassOf<AActor> ActorClass)
+{
+    return ActorClass ? FObjectPoolId(FindOrAddPoolIndex(ActorClass)) : FObjectPoolId();
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::ReserveSlot(const int32 PoolIndex, AActor* NewOwner)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ReserveSlot);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Initialize);
+
+    // Objects destroyed behind the pool's back are dropped first, so the acquire falls through to the next one or grows.
+    DropStaleAvailableSlots(PoolIndex);
+
+    const UClass* ObjectClass = ObjectPools[PoolIndex].ObjectClass;
+    RecordAcquisitions(PoolIndex, 1);
+    if (ObjectPools[PoolIndex].Slots.GetAvailable().Num == 0)
+    {
+        ObjectPools[PoolIndex].Session.GrowthEvents++;
+        const int32 GrowthAmount = GetGrowthAmount(PoolIndex, 1);
+        if (Settings->bEnableBudgetedGrowth)
+        {
+            // The caller would otherwise get nullptr, so one actor is spawned right away and the rest is queued.
+            const bool bGrowthQueued = ObjectPools[PoolIndex].PendingGrowth > 0;
+            if (bGrowthQueued) ObjectPools[PoolIndex].PendingGrowth--;
+            GrowActorPool(PoolIndex, 1);
+            if (!bGrowthQueued) RequestPoolGrowth(PoolIndex, GrowthAmount - 1);
+        }
+        else
+        {
+            GrowActorPool(PoolIndex, GrowthAmount);
+        }
+    }
+
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    if (Pool.Slots.GetAvailable().Num == 0) return INDEX_NONE;
+
+    // Hand out the most recently returned object, it is the one most likely to still be warm in cache.
+    const int32 SlotIndex = Pool.Slots.GetAvailable().Tail;
+    if (!IsValid(Pool.Slots[SlotIndex].Object))
+    {
+        // Only when growing produced an object that was destroyed right away.
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Failed to initialize object from pool for %s"), *ObjectClass->GetName());
+        return INDEX_NONE;
+    }
+
+    Pool.Slots.SetState(SlotIndex, ELazyPoolSlotState::Reserved);
+    Pool.AccessCount++;
+    if (IsValid(NewOwner)) Pool.Slots[SlotIndex].GetActor()->SetOwner(NewOwner);
+    if (Pool.Slots[SlotIndex].IdleTier != EPooledActorIdleTier::Warm) WakeSlotActor(PoolIndex, SlotIndex);
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Initialized object from pool for %s"), *ObjectClass->GetName());
+    return SlotIndex;
+}
+
+void ULazyDynamicObjectPoolSubsystem::DropStaleAvailableSlots(const int32 PoolIndex)
+{
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    while (Pool.Slots.GetAvailable().Num > 0 && !IsValid(Pool.Slots[Pool.Slots.GetAvailable().Tail].Object))
+    {
+        const int32 SlotIndex = Pool.Slots.GetAvailable().Tail;
+        PooledObjectSlots.Remove(Pool.Slots[SlotIndex].Object);
+        Pool.Slots.Release(SlotIndex);
+    }
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::ReserveSlots(const int32 PoolIndex, const int32 Count, AActor* NewOwner, TArray<int32>& OutSlotIndices)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ReserveSlots);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Initialize);
+
+    const UClass* ObjectClass = ObjectPools[PoolIndex].ObjectClass;
+    RecordAcquisitions(PoolIndex, Count);
+    const int32 Shortfall = Count - ObjectPools[PoolIndex].Slots.GetAvailable().Num;
+    if (Shortfall > 0)
+    {
+        ObjectPools[PoolIndex].Session.GrowthEvents++;
+        const int32 GrowthAmount = GetGrowthAmount(PoolIndex, Shortfall);
+        if (Settings->bEnableBudgetedGrowth)
+        {
+            // Only the shortfall is spawned on this frame, whatever the growth amount asks for on top is queued.
+            const bool bGrowthQueued = ObjectPools[PoolIndex].PendingGrowth > 0;
+            ObjectPools[PoolIndex].PendingGrowth = FMath::Max(0, ObjectPools[PoolIndex].PendingGrowth - Shortfall);
+            GrowActorPool(PoolIndex, Shortfall);
+            if (!bGrowthQueued) RequestPoolGrowth(PoolIndex, GrowthAmount - Shortfall);
+        }
+        else
+        {
+            GrowActorPool(PoolIndex, GrowthAmount);
+        }
+    }
+
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    OutSlotIndices.Reserve(OutSlotIndices.Num() + FMath::Min(Count, Pool.Slots.GetAvailable().Num));
+
+    int32 NumReserved = 0;
+    while (NumReserved < Count && Pool.Slots.GetAvailable().Num > 0)
+    {
+        const int32 SlotIndex = Pool.Slots.GetAvailable().Tail;
+        UObject* Object = Pool.Slots[SlotIndex].Object;
+        if (!IsValid(Object))
+        {
+            PooledObjectSlots.Remove(Object);
+            Pool.Slots.Release(SlotIndex);
+            continue;
+        }
+
+        Pool.Slots.SetState(SlotIndex, ELazyPoolSlotState::Reserved);
+        if (IsValid(NewOwner)) Pool.Slots[SlotIndex].GetActor()->SetOwner(NewOwner);
+        OutSlotIndices.Add(SlotIndex);
+        NumReserved++;
+    }
+
+    Pool.AccessCount += NumReserved;
+
+    // Waking runs gameplay code, so it waits until the reservations are done with the pool.
+    for (int32 i = OutSlotIndices.Num() - NumReserved; i < OutSlotIndices.Num(); ++i)
+    {
+        if (ObjectPools[PoolIndex].Slots[OutSlotIndices[i]].IdleTier != EPooledActorIdleTier::Warm)
+        {
+            WakeSlotActor(PoolIndex, OutSlotIndices[i]);
+        }
+    }
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Initialized %d of %d requested objects from pool for %s"), NumReserved, Count, *ObjectClass->GetName());
+    return NumReserved;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetGrowthAmount(const int32 PoolIndex, const int32 MinimumGrowth) const
+{
+    return FMath::Max(MinimumGrowth, GrowthPolicy->GetGrowthAmount(GetDemandStats(PoolIndex), MinimumGrowth));
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetLegacyGrowthAmount(const int32 NumInUse) const
+{
+    return NumInUse == 0
+        ? Settings->DefaultInitialPoolSize
+        : FMath::Max(1, LazyObjectPool::GetFactorGrowth(NumInUse, Settings->PoolGrowthFactor));
+}
+
+void ULazyDynamicObjectPoolSubsystem::RecordAcquisitions(const int32 PoolIndex, const int32 Count)
+{
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    FObjectPool::FPoolDemand& Demand = Pool.Demand;
+    const int32 NumInUse = Pool.Slots.GetNumAcquired();
+
+    Demand.AcquisitionsThisFrame += Count;
+    INC_DWORD_STAT_BY(STAT_LazyObjectPool_Acquisitions, Count);
+    Demand.PeakInUse = FMath::Max(Demand.PeakInUse, NumInUse + Count);
+    Pool.Session.PeakInUse = FMath::Max(Pool.Session.PeakInUse, NumInUse + Count);
+    if (Count > Pool.Slots.GetAvailable().Num)
+    {
+        Demand.NumMisses++;
+        Pool.Session.Misses++;
+        INC_DWORD_STAT(STAT_LazyObjectPool_Misses);
+    }
+
+    // Replay the same acquisitions against the fixed growth factor, which only grew once a pool was empty.
+    for (int32 i = 0; i < Count; ++i)
+    {
+        if (Demand.LegacyFreeActors <= 0)
+        {
+            Demand.NumLegacyMisses++;
+            Demand.LegacyFreeActors = GetLegacyGrowthAmount(NumInUse + i);
+        }
+        Demand.LegacyFreeActors--;
+    }
+}
+
+FObjectPoolDemandStats ULazyDynamicObjectPoolSubsystem::GetDemandStats(const int32 PoolIndex) const
+{
+    const FObjectPool& Pool = ObjectPools[PoolIndex];
+    const UWorld* World = GetWorld();
+
+    FObjectPoolDemandStats Stats;
+    Stats.NumAvailable = Pool.Slots.GetAvailable().Num;
+    Stats.NumInUse = Pool.Slots.GetNumAcquired();
+    Stats.NumPending = Pool.PendingGrowth;
+    Stats.InitialSize = GetInitialSize(PoolIndex);
+    Stats.GrowthFactor = Pool.GrowthFactor;
+    Stats.AcquisitionRate = Pool.Demand.AcquisitionRate;
+    Stats.PeakInUse = FMath::Max(Pool.Demand.PeakInUse, Stats.NumInUse);
+    Stats.TimeSinceLastGrowth = IsValid(World) ? static_cast<float>(World->GetTimeSeconds() - Pool.Demand.LastGrowthTime) : 0.0f;
+    return Stats;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::AcquireActorsFromPool(const TSubclassOf<AActor> ActorClass, const int32 Count,
+const TArrayView<const FTransform> Transforms, TArray<AActor*>& OutActors, AActor* NewOwner)
+{
+    if (!ActorClass || Count <= 0) return 0;
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ActorClass);
+    TArray<int32> SlotIndices;
+    const int32 NumReserved = ReserveSlots(PoolIndex, Count, NewOwner, SlotIndices);
+
+    OutActors.Reserve(OutActors.Num() + NumReserved);
+    for (int32 i = 0; i < NumReserved; ++i)
+    {
+        const FTransform& NewTransform = Transforms.IsEmpty() ? FTransform::Identity : Transforms[FMath::Min(i, Transforms.Num() - 1)];
+        ActivateSlot({ PoolIndex, SlotIndices[i] }, NewTransform, false, nullptr, ETeleportType::None);
+        OutActors.Add(ObjectPools[PoolIndex].Slots[SlotIndices[i]].GetActor());
+    }
+
+    return NumReserved;
+}
+
+TArray<AActor*> ULazyDynamicObjectPoolSubsystem::InitializeActorsFromPool(const TSubclassOf<AActor> ActorClass, const int32 Count, AActor* NewOwner)
+{
+    TArray<AActor*> Actors;
+    if (!ActorClass || Count <= 0) return Actors;
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ActorClass);
+    TArray<int32> SlotIndices;
+    ReserveSlots(PoolIndex, Count, NewOwner, SlotIndices);
+
+    Actors.Reserve(SlotIndices.Num());
+    for (const int32 SlotIndex : SlotIndices)
+    {
+        Actors.Add(ObjectPools[PoolIndex].Slots[SlotIndex].GetActor());
+    }
+    return Actors;
+}
+
+TArray<AActor*> ULazyDynamicObjectPoolSubsystem::FinishInitializeActorsFromPool(const TArray<AActor*>& Actors, const TArray<FTransform>& NewTransforms)
+{
+    TArray<AActor*> ActivatedActors;
+
+    // Any other count would leave some actors at a transform meant for another, the reservations go back instead.
+    if (NewTransforms.Num() > 1 && NewTransforms.Num() != Actors.Num())
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to activate %d actors from pool with %d transforms"), Actors.Num(), NewTransforms.Num());
+        ReturnActorsToPool(Actors);
+        return ActivatedActors;
+    }
+
+    ActivatedActors.Reserve(Actors.Num());
+    for (int32 i = 0; i < Actors.Num(); ++i)
+    {
+        AActor* Actor = Actors[i];
+        const FPoolSlotRef* SlotRef = IsValid(Actor) ? PooledObjectSlots.Find(Actor) : nullptr;
+        if (!SlotRef) continue;
+
+        if (ObjectPools[SlotRef->PoolIndex].Slots.GetState(SlotRef->SlotIndex) != ELazyPoolSlotState::Reserved)
+        {
+            UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to activate actor %s that was not taken from its pool"), *Actor->GetName());
+            continue;
+        }
+
+        const FTransform& NewTransform = NewTransforms.IsEmpty() ? FTransform::Identity : NewTransforms[NewTransforms.Num() == 1 ? 0 : i];
+        ActivateSlot(*SlotRef, NewTransform, false, nullptr, ETeleportType::None);
+        ActivatedActors.Add(Actor);
+    }
+
+    return ActivatedActors;
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::K2_FinishInitializeActorFromPool(AActor* Actor, const FTransform& NewTransform, const bool bSweep,
+FHitResult& SweepHitResult, const bool bTeleport)
+{
+    return FinishInitializeActorFromPool(Actor, NewTransform, bSweep, &SweepHitResult, TeleportFlagToEnum(bTeleport));
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::FinishInitializeActorFromPool(AActor* Actor, const FTransform& NewTransform, const bool bSweep,
+FHitResult* OutSweepHitResult, const ETeleportType Teleport)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(FinishInitializeActorFromPool);
+
+    if (!IsValid(Actor))
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to activate invalid actor from pool"));
+        return nullptr;
+    }
+
+    const FPoolSlotRef* SlotRef = PooledObjectSlots.Find(Actor);
+    if (!SlotRef)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to activate actor of type %s from non-existent pool"), *Actor->GetClass()->GetName());
+        return Actor;
+    }
+
+    // Only an actor reserved by InitializeActorFromPool can be finished. An available one would skip the reservation's
+    // bookkeeping, an in-use one would be activated twice.
+    if (ObjectPools[SlotRef->PoolIndex].Slots.GetState(SlotRef->SlotIndex) != ELazyPoolSlotState::Reserved)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to activate actor %s that was not taken from its pool"), *Actor->GetName());
+        return nullptr;
+    }
+
+    ActivateSlot(*SlotRef, NewTransform, bSweep, OutSweepHitResult, Teleport);
+    return Actor;
+}
+
+void ULazyDynamicObjectPoolSubsystem::ActivateSlot(const FPoolSlotRef SlotRef, const FTransform& NewTransform, const bool bSweep,
+FHitResult* OutSweepHitResult, const ETeleportType Teleport)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ActivateSlot);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_FinishInitialize);
+
+    FObjectPool& Pool = ObjectPools[SlotRef.PoolIndex];
+    const UClass* ActorClass = Pool.ObjectClass;
+    Pool.Slots.SetState(SlotRef.SlotIndex, ELazyPoolSlotState::InUse);
+
+    PlaceSlotActor(SlotRef, NewTransform, bSweep, OutSweepHitResult, Teleport);
+    // Activate the actor and its components, collision is already back on so this does not touch the scene again
+    ActivateSlotActor(SlotRef.PoolIndex, SlotRef.SlotIndex);
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Activated actor from pool for %s"), *ActorClass->GetName());
+}
+
+void ULazyDynamicObjectPoolSubsystem::PlaceSlotActor(const FPoolSlotRef SlotRef, const FTransform& NewTransform, const bool bSweep,
+FHitResult* OutSweepHitResult, const ETeleportType Teleport)
+{
+    AActor* Actor = ObjectPools[SlotRef.PoolIndex].Slots[SlotRef.SlotIndex].GetActor();
+    const FActivationPlan Plan = ObjectPools[SlotRef.PoolIndex].ActivationPlan;
+
+    // Coming out of the parking location is a teleport, not a move physics should derive a velocity from,
+    // and a sweep from there would stop at whatever lies between the parking location and the new one.
+    const bool bParked = Plan.ParkingMode == EPooledActorParkingMode::Isolated;
+    const bool bPlacementSweep = bSweep && !bParked;
+    const ETeleportType PlacementTeleport = bParked && Teleport == ETeleportType::None ? ETeleportType::TeleportPhysics : Teleport;
+
+    // Components with overlap events switched off skip their overlap queries, they are switched back on after the placement.
+    TInlineComponentArray<UPrimitiveComponent*> SuppressedOverlaps;
+    if (Plan.OverlapMode != EPooledActorOverlapMode::Immediate)
+    {
+        Actor->ForEachComponent<UPrimitiveComponent>(false, [&SuppressedOverlaps](UPrimitiveComponent* Primitive)
+        {
+            if (!Primitive->GetGenerateOverlapEvents()) return;
+            Primitive->SetGenerateOverlapEvents(false);
+            SuppressedOverlaps.Add(Primitive);
+        });
+    }
+
+    {
+        // Collision goes back on before the move and both are batched, so the physics filter change, the transform
+        // and the overlap update reach the scene once instead of the move and the collision re-enable each updating overlaps.
+        FScopedMovementUpdate ScopedPlacement(Actor->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+        if (Plan.bToggleCollision) Actor->SetActorEnableCollision(true);
+        Actor->SetActorTransform(NewTransform, bPlacementSweep, OutSweepHitResult, PlacementTeleport);
+    }
+
+    for (UPrimitiveComponent* Primitive : SuppressedOverlaps)
+    {
+        if (IsValid(Primitive)) Primitive->SetGenerateOverlapEvents(true);
+    }
+
+    // Overlap callbacks run gameplay code, so the generation is read after the placement.
+    if (Plan.OverlapMode == EPooledActorOverlapMode::Deferred)
+    {
+        const uint32 Generation = ObjectPools[SlotRef.PoolIndex].Slots.GetGeneration(SlotRef.SlotIndex);
+        PendingOverlapUpdates.Add(FPooledActorHandle(SlotRef.PoolIndex, SlotRef.SlotIndex, Generation));
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::ProcessPendingOverlapUpdates()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessPendingOverlapUpdates);
+
+    if (PendingOverlapUpdates.IsEmpty()) return;
+
+    // Overlap callbacks can acquire more deferred actors, those are left for the next tick.
+    const TArray<FPooledActorHandle> Updates = MoveTemp(PendingOverlapUpdates);
+    PendingOverlapUpdates.Reset();
+    for (const FPooledActorHandle& Handle : Updates)
+    {
+        // Actors returned since their acquisition no longer match the handle and are skipped.
+        if (AActor* Actor = GetActorFromHandle(Handle))
+        {
+            Actor->UpdateOverlaps();
+        }
+    }
+}
+
+bool ULazyDynamicObjectPoolSubsystem::RegisterProjectileClass(const TSubclassOf<AActor> ActorClass, const FPooledProjectileConfig& Config)
+{
+    UWorld* World = GetWorld();
+    if (!ActorClass || !IsValid(World)) return false;
+
+    int32 ClassIndex = INDEX_NONE;
+    if (const int32* FoundClassIndex = ProjectileRecordsByClass.Find(ActorClass))
+    {
+        ClassIndex = *FoundClassIndex;
+    }
+    else
+    {
+        // Owned by the world like pooled components, its instances stand in for every flying actor of the class.
+        UInstancedStaticMeshComponent* Renderer = NewObject<UInstancedStaticMeshComponent>(World);
+        Renderer->SetMobility(EComponentMobility::Movable);
+        Renderer->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Renderer->SetCanEverAffectNavigation(false);
+        Renderer->RegisterComponentWithWorld(World);
+
+        ClassIndex = ProjectileRecords.AddDefaulted();
+        ProjectileRecords[ClassIndex].ActorClass = ActorClass;
+        ProjectileRecords[ClassIndex].Renderer = Renderer;
+        ProjectileRecordsByClass.Add(ActorClass, ClassIndex);
+    }
+
+    FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+    Records.Config = Config;
+    Records.Renderer->SetStaticMesh(Config.Mesh);
+
+    // Resolved now so the first hit does not pay for creating the actor pool.
+    FindOrAddPoolIndex(ActorClass);
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Registered %s as a projectile class"), *ActorClass->GetName());
+    return true;
+}
+
+FPooledProjectileHandle ULazyDynamicObjectPoolSubsystem::LaunchProjectile(const TSubclassOf<AActor> ActorClass, const FVector Location,
+const FVector Velocity, const float Lifetime)
+{
+    const int32* ClassIndex = ActorClass ? ProjectileRecordsByClass.Find(ActorClass) : nullptr;
+    if (!ClassIndex)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to launch a projectile of %s, which is not registered as a projectile class"), *GetNameSafe(ActorClass));
+        return FPooledProjectileHandle();
+    }
+
+    return AddProjectileRecord(*ClassIndex, Location, Velocity, Lifetime);
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::MaterializeProjectile(const FPooledProjectileHandle& Handle)
+{
+    const int32 Record = FindProjectileRecord(Handle);
+    if (Record == INDEX_NONE) return nullptr;
+
+    const int32 ClassIndex = Handle.GetClassIndex();
+    const FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+    const FVector Location = Records.Positions[Record];
+    const FVector Velocity = Records.Velocities[Record];
+    const float RemainingLifetime = Records.RemainingLifetimes[Record];
+
+    // The record only ends once there is an actor to carry on its flight, a full pool leaves it flying.
+    AActor* Actor = MaterializeProjectileRecord(ClassIndex, Location, Velocity, RemainingLifetime, FHitResult());
+    if (!Actor) return nullptr;
+
+    // Activation runs gameplay that may have launched or dropped records, so it is looked up again.
+    const int32 MaterializedRecord = FindProjectileRecord(Handle);
+    if (MaterializedRecord != INDEX_NONE)
+    {
+        RemoveProjectileRecord(ClassIndex, MaterializedRecord);
+    }
+    return Actor;
+}
+
+FPooledProjectileHandle ULazyDynamicObjectPoolSubsystem::DematerializeProjectile(AActor* Actor)
+{
+    if (!IsValid(Actor) || !ProjectileRecordsByClass.Contains(Actor->GetClass())) return FPooledProjectileHandle();
+
+    const FPooledProjectileHandle Handle = ResumeProjectileRecord(Actor);
+    ReturnActorToPool(Actor);
+    return Handle;
+}
+
+void ULazyDynamicObjectPoolSubsystem::DropProjectile(const FPooledProjectileHandle& Handle)
+{
+    const int32 Record = FindProjectileRecord(Handle);
+    if (Record != INDEX_NONE)
+    {
+        RemoveProjectileRecord(Handle.GetClassIndex(), Record);
+    }
+}
+
+bool ULazyDynamicObjectPoolSubsystem::IsProjectileHandleValid(const FPooledProjectileHandle& Handle) const
+{
+    return FindProjectileRecord(Handle) != INDEX_NONE;
+}
+
+bool ULazyDynamicObjectPoolSubsystem::GetProjectileLocation(const FPooledProjectileHandle& Handle, FVector& OutLocation) const
+{
+    const int32 Record = FindProjectileRecord(Handle);
+    if (Record == INDEX_NONE) return false;
+
+    OutLocation = ProjectileRecords[Handle.GetClassIndex()].Positions[Record];
+    return true;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetNumProjectileRecords(const TSubclassOf<AActor> ActorClass) const
+{
+    const int32* ClassIndex = ProjectileRecordsByClass.Find(ActorClass);
+    return ClassIndex ? ProjectileRecords[*ClassIndex].Num() : 0;
+}
+
+FPooledProjectileHandle ULazyDynamicObjectPoolSubsystem::AddProjectileRecord(const int32 ClassIndex, const FVector& Location,
+const FVector& Velocity, const float Lifetime)
+{
+    FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+    int32 Id = INDEX_NONE;
+    if (!Records.FreeIds.IsEmpty())
+    {
+        Id = Records.FreeIds.Pop();
+    }
+    else
+    {
+        Id = Records.RecordById.Add(INDEX_NONE);
+        Records.GenerationById.Add(0);
+    }
+
+    Records.RecordById[Id] = Records.Positions.Add(Location);
+    Records.Velocities.Add(Velocity);
+    Records.RemainingLifetimes.Add(Lifetime > 0.0f ? Lifetime : Records.Config.DefaultLifetime);
+    Records.IdByRecord.Add(Id);
+    return FPooledProjectileHandle(ClassIndex, Id, Records.GenerationById[Id]);
+}
+
+void ULazyDynamicObjectPoolSubsystem::RemoveProjectileRecord(const int32 ClassIndex, const int32 Record)
+{
+    FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+    const int32 Id = Records.IdByRecord[Record];
+    Records.Positions.RemoveAtSwap(Record);
+    Records.Velocities.RemoveAtSwap(Record);
+    Records.RemainingLifetimes.RemoveAtSwap(Record);
+    Records.IdByRecord.RemoveAtSwap(Record);
+
+    // The last record moved into the removed one's place.
+    if (Record < Records.Num())
+    {
+        Records.RecordById[Records.IdByRecord[Record]] = Record;
+    }
+    Records.RecordById[Id] = INDEX_NONE;
+    Records.GenerationById[Id]++;
+    Records.FreeIds.Add(Id);
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::FindProjectileRecord(const FPooledProjectileHandle& Handle) const
+{
+    if (!ProjectileRecords.IsValidIndex(Handle.GetClassIndex())) return INDEX_NONE;
+
+    const FProjectileRecords& Records = ProjectileRecords[Handle.GetClassIndex()];
+    if (!Records.RecordById.IsValidIndex(Handle.GetId()) || Records.GenerationById[Handle.GetId()] != Handle.GetGeneration()) return INDEX_NONE;
+    return Records.RecordById[Handle.GetId()];
+}
+
+void ULazyDynamicObjectPoolSubsystem::ProcessProjectileRecords(const float DeltaTime)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessProjectileRecords);
+
+    if (ProjectileRecords.IsEmpty() || DeltaTime <= 0.0f) return;
+
+    struct FProjectileHit
+    {
+        FPooledProjectileHandle Handle;
+        FHitResult Hit;
+    };
+    TArray<FProjectileHit> Hits;
+    TArray<FVector> PreviousPositions;
+    const float GravityZ = GetWorld()->GetGravityZ();
+    const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PooledProjectileStep), false);
+
+    for (int32 ClassIndex = 0; ClassIndex < ProjectileRecords.Num(); ++ClassIndex)
+    {
+        FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+        const int32 NumRecords = Records.Num();
+        if (NumRecords > 0)
+        {
+            if (Records.Config.bMaterializeOnHit) PreviousPositions = Records.Positions;
+
+            // Straight loops over separate arrays, which the compiler can turn into packed vector math.
+            const FVector GravityStep(0.0, 0.0, GravityZ * Records.Config.GravityScale * DeltaTime);
+            FVector* RESTRICT Positions = Records.Positions.GetData();
+            FVector* RESTRICT Velocities = Records.Velocities.GetData();
+            float* RESTRICT Lifetimes = Records.RemainingLifetimes.GetData();
+            for (int32 Record = 0; Record < NumRecords; ++Record)
+            {
+                Velocities[Record] += GravityStep;
+                Positions[Record] += Velocities[Record] * DeltaTime;
+            }
+            for (int32 Record = 0; Record < NumRecords; ++Record)
+            {
+                Lifetimes[Record] -= DeltaTime;
+            }
+
+            if (Records.Config.bMaterializeOnHit)
+            {
+                for (int32 Record = 0; Record < NumRecords; ++Record)
+                {
+                    FHitResult Hit;
+                    if (!GetWorld()->LineTraceSingleByChannel(Hit, PreviousPositions[Record], Positions[Record], Records.Config.TraceChannel, QueryParams)) continue;
+
+                    // The record waits at the hit point and comes back as an actor once every class has been stepped.
+                    const int32 Id = Records.IdByRecord[Record];
+                    Hits.Add({ FPooledProjectileHandle(ClassIndex, Id, Records.GenerationById[Id]), Hit });
+                    Positions[Record] = Hit.Location;
+                }
+            }
+
+            // Backwards, so the record swapped into a removed one's place has already been checked.
+            for (int32 Record = NumRecords - 1; Record >= 0; --Record)
+            {
+                if (Records.RemainingLifetimes[Record] <= 0.0f) RemoveProjectileRecord(ClassIndex, Record);
+            }
+        }
+        SyncProjectileRenderer(ClassIndex);
+    }
+
+    // Materialising runs gameplay code that may launch, drop or register projectiles, so it waits until the step is done
+    // and every record is looked up again by its handle.
+    for (const FProjectileHit& Hit : Hits)
+    {
+        const int32 Record = FindProjectileRecord(Hit.Handle);
+        if (Record == INDEX_NONE) continue;
+
+        const int32 ClassIndex = Hit.Handle.GetClassIndex();
+        const FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+
+        // A full pool leaves the record at the hit point, it tries again next frame until its lifetime runs out.
+        if (!MaterializeProjectileRecord(ClassIndex, Records.Positions[Record], Records.Velocities[Record], Records.RemainingLifetimes[Record], Hit.Hit)) continue;
+
+        const int32 MaterializedRecord = FindProjectileRecord(Hit.Handle);
+        if (MaterializedRecord != INDEX_NONE)
+        {
+            RemoveProjectileRecord(ClassIndex, MaterializedRecord);
+        }
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::SyncProjectileRenderer(const int32 ClassIndex)
+{
+    const FProjectileRecords& Records = ProjectileRecords[ClassIndex];
+    UInstancedStaticMeshComponent* Renderer = Records.Renderer;
+    if (!IsValid(Renderer)) return;
+
+    const int32 NumRecords = Records.Num();
+    const int32 NumInstances = Renderer->GetInstanceCount();
+    if (NumRecords == 0 && NumInstances == 0) return;
+
+    TArray<FTransform> Transforms;
+    Transforms.SetNumUninitialized(NumRecords);
+    for (int32 Record = 0; Record < NumRecords; ++Record)
+    {
+        Transforms[Record] = FTransform(Records.Velocities[Record].Rotation(), Records.Positions[Record]);
+    }
+
+    // Instances are only ever added or removed at the end, all of them are moved in one batch.
+    if (NumInstances < NumRecords)
+    {
+        Renderer->AddInstances(TArray<FTransform>(Transforms.GetData() + NumInstances, NumRecords - NumInstances), false, true);
+    }
+    else if (NumInstances > NumRecords)
+    {
+        TArray<int32> RemovedInstances;
+        RemovedInstances.Reserve(NumInstances - NumRecords);
+        for (int32 Instance = NumInstances - 1; Instance >= NumRecords; --Instance)
+        {
+            RemovedInstances.Add(Instance);
+        }
+        Renderer->RemoveInstances(RemovedInstances);
+    }
+
+    if (NumRecords > 0)
+    {
+        Renderer->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+    }
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::MaterializeProjectileRecord(const int32 ClassIndex, const FVector& Location, const FVector& Velocity,
+const float RemainingLifetime, const FHitResult& Hit)
+{
+    const TSubclassOf<AActor> ActorClass = ProjectileRecords[ClassIndex].ActorClass;
+    AActor* Actor = GetActorFromHandle(AcquireActorFromPool(ActorClass, FTransform(Velocity.Rotation(), Location)));
+    if (!Actor) return nullptr;
+
+    // The acquire reactivated the movement component, it only has to pick the flight up where the record left it.
+    if (UProjectileMovementComponent* Movement = Actor->FindComponentByClass<UProjectileMovementComponent>())
+    {
+        Movement->Velocity = Velocity;
+    }
+    MaterializedProjectiles.Add(Actor, { ClassIndex, RemainingLifetime, GetWorld()->GetTimeSeconds() });
+
+    OnProjectileMaterialized.Broadcast(Actor, Hit);
+    return Actor;
+}
+
+FPooledProjectileHandle ULazyDynamicObjectPoolSubsystem::ResumeProjectileRecord(AActor* Actor)
+{
+    const int32* ClassIndex = ProjectileRecordsByClass.Find(Actor->GetClass());
+    if (!ClassIndex) return FPooledProjectileHandle();
+
+    // Actors that never were a record fly for the class default.
+    float Lifetime = 0.0f;
+    FMaterializedProjectile Materialized;
+    if (MaterializedProjectiles.RemoveAndCopyValue(Actor, Materialized))
+    {
+        Lifetime = Materialized.RemainingLifetime - static_cast<float>(GetWorld()->GetTimeSeconds() - Materialized.MaterializedTime);
+        if (Lifetime <= 0.0f) return FPooledProjectileHandle();
+    }
+
+    const UProjectileMovementComponent* Movement = Actor->FindComponentByClass<UProjectileMovementComponent>();
+    const FVector Velocity = Movement ? Movement->Velocity : Actor->GetVelocity();
+    return AddProjectileRecord(*ClassIndex, Actor->GetActorLocation(), Velocity, Lifetime);
+}
+
+bool ULazyDynamicObjectPoolSubsystem::RegisterDehydrationClass(const FObjectPoolDehydrationClass& DehydrationClass)
+{
+    UWorld* World = GetWorld();
+    const TSubclassOf<AActor> ActorClass = DehydrationClass.ActorClass.LoadSynchronous();
+    if (!ActorClass || !IsValid(World)) return false;
+
+    int32 DehydratedIndex = INDEX_NONE;
+    if (const int32* FoundIndex = DehydratedActorsByClass.Find(ActorClass))
+    {
+        DehydratedIndex = *FoundIndex;
+    }
+    else
+    {
+        // Owned by the world like pooled components, its instances stand in for every dehydrated actor of the class.
+        UHierarchicalInstancedStaticMeshComponent* Renderer = NewObject<UHierarchicalInstancedStaticMeshComponent>(World);
+        Renderer->SetMobility(EComponentMobility::Movable);
+        Renderer->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Renderer->SetCanEverAffectNavigation(false);
+        Renderer->RegisterComponentWithWorld(World);
+
+        DehydratedIndex = DehydratedActors.AddDefaulted();
+        DehydratedActors[DehydratedIndex].ActorClass = ActorClass;
+        DehydratedActors[DehydratedIndex].Renderer = Renderer;
+        DehydratedActorsByClass.Add(ActorClass, DehydratedIndex);
+    }
+
+    FDehydratedActors& Dehydrated = DehydratedActors[DehydratedIndex];
+    const double RehydrateDistance = FMath::Min(DehydrationClass.RehydrateDistance, DehydrationClass.DehydrateDistance);
+    Dehydrated.DehydrateDistanceSquared = FMath::Square(static_cast<double>(DehydrationClass.DehydrateDistance));
+    Dehydrated.RehydrateDistanceSquared = FMath::Square(RehydrateDistance);
+    Dehydrated.Renderer->SetStaticMesh(DehydrationClass.Mesh.LoadSynchronous());
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Registered %s for dehydration beyond %.0f"), *ActorClass->GetName(), DehydrationClass.DehydrateDistance);
+    return true;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetNumDehydratedActors(const TSubclassOf<AActor> ActorClass) const
+{
+    const int32* DehydratedIndex = DehydratedActorsByClass.Find(ActorClass);
+    return DehydratedIndex ? DehydratedActors[*DehydratedIndex].Transforms.Num() : 0;
+}
+
+void ULazyDynamicObjectPoolSubsystem::ProcessDehydration()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessDehydration);
+
+    if (DehydratedActors.IsEmpty()) return;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now < NextDehydrationCheckTime) return;
+    NextDehydrationCheckTime = Now + Settings->DehydrationCheckInterval;
+
+    TArray<FVector, TInlineAllocator<4>> Viewers;
+    for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+    {
+        if (const APlayerController* PlayerController = Iterator->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            Viewers.Add(ViewLocation);
+        }
+    }
+    // Without anyone looking, nothing is far or close.
+    if (Viewers.IsEmpty()) return;
+
+    auto GetClosestViewerDistanceSquared = [&Viewers](const FVector& Location)
+    {
+        double ClosestDistanceSquared = TNumericLimits<double>::Max();
+        for (const FVector& Viewer : Viewers)
+        {
+            ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(Viewer, Location));
+        }
+        return ClosestDistanceSquared;
+    };
+
+    int32 SwapBudget = Settings->MaxDehydrationSwapsPerCheck;
+    for (int32 DehydratedIndex = 0; DehydratedIndex < DehydratedActors.Num() && SwapBudget > 0; ++DehydratedIndex)
+    {
+        // Entries are taken out before anything is acquired, acquiring runs gameplay code that may dehydrate or register more.
+        TArray<FTransform, TInlineAllocator<16>> RehydratedTransforms;
+        TArray<TArray<uint8>, TInlineAllocator<16>> RehydratedStates;
+        TArray<TWeakObjectPtr<AActor>, TInlineAllocator<16>> RehydratedOriginals;
+        {
+            FDehydratedActors& Dehydrated = DehydratedActors[DehydratedIndex];
+            for (int32 Entry = Dehydrated.Transforms.Num() - 1; Entry >= 0 && RehydratedTransforms.Num() < SwapBudget; --Entry)
+            {
+                if (GetClosestViewerDistanceSquared(Dehydrated.Transforms[Entry].GetLocation()) > Dehydrated.RehydrateDistanceSquared) continue;
+
+                RehydratedTransforms.Add(Dehydrated.Transforms[Entry]);
+                RehydratedStates.Add(MoveTemp(Dehydrated.States[Entry]));
+                RehydratedOriginals.Add(Dehydrated.OriginalActors[Entry]);
+                RemoveDehydratedActor(DehydratedIndex, Entry);
+            }
+        }
+        SwapBudget -= RehydratedTransforms.Num();
+        for (int32 i = 0; i < RehydratedTransforms.Num(); ++i)
+        {
+            RehydrateActor(DehydratedIndex, RehydratedTransforms[i], RehydratedStates[i], RehydratedOriginals[i]);
+        }
+
+        const int32* PoolIndex = PoolIndexByClass.Find(DehydratedActors[DehydratedIndex].ActorClass);
+        if (!PoolIndex || SwapBudget <= 0) continue;
+
+        // Same for the actors going the other way, returning them runs their deactivation.
+        TArray<AActor*, TInlineAllocator<16>> DehydratingActors;
+        const FObjectPool& Pool = ObjectPools[*PoolIndex];
+        const double DehydrateDistanceSquared = DehydratedActors[DehydratedIndex].DehydrateDistanceSquared;
+        for (int32 SlotIndex = Pool.Slots.GetInUse().Head; SlotIndex != INDEX_NONE && DehydratingActors.Num() < SwapBudget; SlotIndex = Pool.Slots.GetNext(SlotIndex))
+        {
+            AActor* Actor = Pool.Slots[SlotIndex].GetActor();
+            if (IsValid(Actor) && GetClosestViewerDistanceSquared(Actor->GetActorLocation()) > DehydrateDistanceSquared)
+            {
+                DehydratingActors.Add(Actor);
+            }
+        }
+        SwapBudget -= DehydratingActors.Num();
+        for (AActor* Actor : DehydratingActors)
+        {
+            DehydrateActor(DehydratedIndex, Actor);
+        }
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::DehydrateActor(const int32 DehydratedIndex, AActor* Actor)
+{
+    // An earlier dehydration in the same batch may have had gameplay return this actor already.
+    if (!IsValid(Actor) || !GetPooledActorHandle(Actor).IsSet()) return;
+
+    TArray<uint8> State;
+    if (Actor->Implements<UPoolableActorInterface>())
+    {
+        State = IPoolableActorInterface::Execute_OnDehydrateInPool(Actor);
+    }
+    OnActorDehydrated.Broadcast(Actor);
+    if (!GetPooledActorHandle(Actor).IsSet()) return;
+
+    AddDehydratedActor(DehydratedIndex, Actor->GetActorTransform(), MoveTemp(State), Actor);
+    ReturnActorToPool(Actor);
+}
+
+void ULazyDynamicObjectPoolSubsystem::RehydrateActor(const int32 DehydratedIndex, const FTransform& Transform, const TArray<uint8>& State,
+    const TWeakObjectPtr<AActor>& OriginalActor)
+{
+    AActor* Actor = GetActorFromHandle(AcquireActorFromPool(DehydratedActors[DehydratedIndex].ActorClass, Transform));
+    if (!Actor)
+    {
+        // The pool is at its size limit, the actor stays dehydrated until there is room.
+        AddDehydratedActor(DehydratedIndex, Transform, TArray<uint8>(State), OriginalActor);
+        return;
+    }
+
+    if (Actor->Implements<UPoolableActorInterface>())
+    {
+        IPoolableActorInterface::Execute_OnRehydrateFromPool(Actor, State);
+    }
+    OnActorRehydrated.Broadcast(OriginalActor.Get(), Actor);
+}
+
+void ULazyDynamicObjectPoolSubsystem::AddDehydratedActor(const int32 DehydratedIndex, const FTransform& Transform, TArray<uint8>&& State,
+    const TWeakObjectPtr<AActor>& OriginalActor)
+{
+    FDehydratedActors& Dehydrated = DehydratedActors[DehydratedIndex];
+    Dehydrated.Transforms.Add(Transform);
+    Dehydrated.States.Add(MoveTemp(State));
+    Dehydrated.OriginalActors.Add(OriginalActor);
+    if (IsValid(Dehydrated.Renderer))
+    {
+        Dehydrated.Renderer->AddInstance(Transform, true);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::RemoveDehydratedActor(const int32 DehydratedIndex, const int32 Entry)
+{
+    FDehydratedActors& Dehydrated = DehydratedActors[DehydratedIndex];
+    const int32 LastEntry = Dehydrated.Transforms.Num() - 1;
+
+    // Mirrors the swap on the instances, so instance i keeps drawing entry i whatever order the component removes in.
+    if (IsValid(Dehydrated.Renderer))
+    {
+        if (Entry != LastEntry)
+        {
+            Dehydrated.Renderer->UpdateInstanceTransform(Entry, Dehydrated.Transforms[LastEntry], true, true, true);
+        }
+        Dehydrated.Renderer->RemoveInstance(LastEntry);
+    }
+    Dehydrated.Transforms.RemoveAtSwap(Entry);
+    Dehydrated.States.RemoveAtSwap(Entry);
+    Dehydrated.OriginalActors.RemoveAtSwap(Entry);
+}
+
+void ULazyDynamicObjectPoolSubsystem::ReturnActorToPool(AActor* Actor)
+{
+    ReturnObjectToPool(Actor);
+}
+
+void ULazyDynamicObjectPoolSubsystem::ReturnComponentToPool(UActorComponent* Component)
+{
+    ReturnObjectToPool(Component);
+}
+
+void ULazyDynamicObjectPoolSubsystem::ReturnObjectToPool(UObject* Object)
+{
+    if (!IsValid(Object)) return;
+
+    const UClass* ObjectClass = Object->GetClass();
+    const FPoolSlotRef* FoundSlotRef = PooledObjectSlots.Find(Object);
+    if (!FoundSlotRef)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Attempted to return object of type %s to non-existent pool"), *ObjectClass->GetName());
+        return;
+    }
+
+    if (ObjectPools[FoundSlotRef->PoolIndex].Slots.GetState(FoundSlotRef->SlotIndex) == ELazyPoolSlotState::Available)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Ignored double return of object %s"), *Object->GetName());
+        return;
+    }
+
+    ReturnSlotToPool(*FoundSlotRef);
+}
+
+UActorComponent* ULazyDynamicObjectPoolSubsystem::AcquireComponentFromPool(const TSubclassOf<UActorComponent> ComponentClass, USceneComponent* AttachTo,
+const FTransform& Transform, const FName SocketName)
+{
+    if (!ComponentClass || ComponentClass->HasAnyClassFlags(CLASS_Abstract) || !IsValid(GetWorld())) return nullptr;
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ComponentClass);
+    const int32 SlotIndex = ReserveSlot(PoolIndex, nullptr);
+    if (SlotIndex == INDEX_NONE) return nullptr;
+
+    ObjectPools[PoolIndex].Slots.SetState(SlotIndex, ELazyPoolSlotState::InUse);
+    UActorComponent* Component = static_cast<UActorComponent*>(ObjectPools[PoolIndex].Slots[SlotIndex].Object);
+    if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+    {
+        if (IsValid(AttachTo))
+        {
+            SceneComponent->AttachToComponent(AttachTo, FAttachmentTransformRules::KeepRelativeTransform, SocketName);
+            SceneComponent->SetRelativeTransform(Transform);
+        }
+        else
+        {
+            SceneComponent->SetWorldTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+        }
+    }
+    ActivatePooledComponent(Component, ObjectPools[PoolIndex].ActivationPlan);
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Activated component from pool for %s"), *ComponentClass->GetName());
+    return Component;
+}
+
+UObject* ULazyDynamicObjectPoolSubsystem::AcquireObjectFromPool(const TSubclassOf<UObject> ObjectClass)
+{
+    if (!ObjectClass || ObjectClass->HasAnyClassFlags(CLASS_Abstract)) return nullptr;
+    if (ObjectClass->IsChildOf<AActor>() || ObjectClass->IsChildOf<UActorComponent>())
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("%s must be acquired through AcquireActorFromPool or AcquireComponentFromPool"), *ObjectClass->GetName());
+        return nullptr;
+    }
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ObjectClass);
+    const int32 SlotIndex = ReserveSlot(PoolIndex, nullptr);
+    if (SlotIndex == INDEX_NONE) return nullptr;
+
+    ObjectPools[PoolIndex].Slots.SetState(SlotIndex, ELazyPoolSlotState::InUse);
+    UObject* Object = ObjectPools[PoolIndex].Slots[SlotIndex].Object;
+    if (ObjectPools[PoolIndex].ActivationPlan.bImplementsInterface)
+    {
+        IPoolableActorInterface::Execute_OnActivateFromPool(Object);
+    }
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Activated object from pool for %s"), *ObjectClass->GetName());
+    return Object;
+}
+
+void ULazyDynamicObjectPoolSubsystem::ReturnActorsToPool(const TArrayView<AActor* const> Actors)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ReturnActorsToPool);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Return);
+
+    // The generation pins each return to the acquisition it was made for, callbacks may return and re-acquire batch members.
+    struct FBatchedReturn
+    {
+        FPoolSlotRef SlotRef;
+        uint32 Generation = 0;
+    };
+
+    TArray<FBatchedReturn, TInlineAllocator<64>> Returns;
+    Returns.Reserve(Actors.Num());
+    for (AActor* Actor : Actors)
+    {
+        const FPoolSlotRef* SlotRef = IsValid(Actor) ? PooledObjectSlots.Find(Actor) : nullptr;
+        if (SlotRef && ObjectPools[SlotRef->PoolIndex].Slots.IsAcquired(SlotRef->SlotIndex)
+            && !ObjectPools[SlotRef->PoolIndex].Slots[SlotRef->SlotIndex].bReturning)
+        {
+            Returns.Add({ *SlotRef, ObjectPools[SlotRef->PoolIndex].Slots.GetGeneration(SlotRef->SlotIndex) });
+        }
+    }
+    if (Returns.IsEmpty()) return;
+
+    // Group by pool so each pool is touched in one contiguous run, duplicates end up adjacent.
+    Algo::Sort(Returns, [](const FBatchedReturn& A, const FBatchedReturn& B)
+    {
+        return A.SlotRef.PoolIndex != B.SlotRef.PoolIndex ? A.SlotRef.PoolIndex < B.SlotRef.PoolIndex : A.SlotRef.SlotIndex < B.SlotRef.SlotIndex;
+    });
+
+    auto IsStillAcquired = [this](const FBatchedReturn& Return)
+    {
+        return ObjectPools[Return.SlotRef.PoolIndex].Slots.IsCurrent({ Return.SlotRef.SlotIndex, Return.Generation });
+    };
+
+    // Returns of batch members made from deactivation callbacks are ignored, the batch returns them itself.
+    for (const FBatchedReturn& Return : Returns)
+    {
+        ObjectPools[Return.SlotRef.PoolIndex].Slots[Return.SlotRef.SlotIndex].bReturning = true;
+    }
+
+    int32 RunStart = 0;
+    while (RunStart < Returns.Num())
+    {
+        const int32 PoolIndex = Returns[RunStart].SlotRef.PoolIndex;
+        int32 RunEnd = RunStart;
+        while (RunEnd < Returns.Num() && Returns[RunEnd].SlotRef.PoolIndex == PoolIndex) ++RunEnd;
+
+        int32 PreviousSlot = INDEX_NONE;
+        for (int32 i = RunStart; i < RunEnd; ++i)
+        {
+            if (Returns[i].SlotRef.SlotIndex == PreviousSlot) continue;
+            PreviousSlot = Returns[i].SlotRef.SlotIndex;
+
+            // A deactivation callback may have destroyed or released this one, like the single return path checks.
+            if (!IsStillAcquired(Returns[i])) continue;
+            DeactivateSlot(PoolIndex, PreviousSlot);
+        }
+
+        FObjectPool& Pool = ObjectPools[PoolIndex];
+        int32 NumReturned = 0;
+        for (int32 i = RunStart; i < RunEnd; ++i)
+        {
+            // Nested returns have all finished by now, nothing else can be holding the flag of this slot.
+            Pool.Slots[Returns[i].SlotRef.SlotIndex].bReturning = false;
+            if (!IsStillAcquired(Returns[i])) continue;
+
+            Pool.Slots.SetState(Returns[i].SlotRef.SlotIndex, ELazyPoolSlotState::Available);
+            Pool.Slots[Returns[i].SlotRef.SlotIndex].LastReturnedTime = GetWorld()->GetTimeSeconds();
+            NumReturned++;
+        }
+        Pool.Demand.LegacyFreeActors += NumReturned;
+
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Returned %d actors to pool for %s"), NumReturned, *Pool.ObjectClass->GetName());
+        RunStart = RunEnd;
+    }
+
+    OnActorAddedToPool.Broadcast();
+}
+
+FPooledActorHandle ULazyDynamicObjectPoolSubsystem::AcquireActorFromPool(const TSubclassOf<AActor> ActorClass, const FTransform& NewTransform, AActor* NewOwner)
+{
+    if (!ActorClass) return FPooledActorHandle();
+
+    const int32 PoolIndex = FindOrAddPoolIndex(ActorClass);
+    const int32 SlotIndex = ReserveSlot(PoolIndex, NewOwner);
+    if (SlotIndex == INDEX_NONE) return FPooledActorHandle();
+
+    const uint32 Generation = ObjectPools[PoolIndex].Slots.GetGeneration(SlotIndex);
+    ActivateSlot({ PoolIndex, SlotIndex }, NewTransform, false, nullptr, ETeleportType::None);
+    return FPooledActorHandle(PoolIndex, SlotIndex, Generation);
+}
+
+bool ULazyDynamicObjectPoolSubsystem::ReturnActorHandleToPool(const FPooledActorHandle& Handle)
+{
+    if (!FindAcquiredSlot(Handle))
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Ignored return of stale handle (pool %d, slot %d)"), Handle.GetPoolIndex(), Handle.GetSlotIndex());
+        return false;
+    }
+
+    ReturnSlotToPool({ Handle.GetPoolIndex(), Handle.GetSlotIndex() });
+    return true;
+}
+
+FPooledActorHandle ULazyDynamicObjectPoolSubsystem::GetPooledActorHandle(const AActor* Actor) const
+{
+    const FPoolSlotRef* SlotRef = PooledObjectSlots.Find(Actor);
+    if (!SlotRef) return FPooledActorHandle();
+
+    const FObjectPool& Pool = ObjectPools[SlotRef->PoolIndex];
+    if (!Pool.Slots.IsAcquired(SlotRef->SlotIndex)) return FPooledActorHandle();
+
+    return FPooledActorHandle(SlotRef->PoolIndex, SlotRef->SlotIndex, Pool.Slots.GetGeneration(SlotRef->SlotIndex));
+}
+
+bool ULazyDynamicObjectPoolSubsystem::IsPooledActorHandleValid(const FPooledActorHandle& Handle) const
+{
+    return FindAcquiredSlot(Handle) != nullptr;
+}
+
+AActor* ULazyDynamicObjectPoolSubsystem::GetActorFromHandle(const FPooledActorHandle& Handle) const
+{
+    const FPoolSlot* Slot = FindAcquiredSlot(Handle);
+    return Slot ? Cast<AActor>(Slot->Object) : nullptr;
+}
+
+const ULazyDynamicObjectPoolSubsystem::FPoolSlot* ULazyDynamicObjectPoolSubsystem::FindAcquiredSlot(const FPooledActorHandle& Handle) const
+{
+    if (!ObjectPools.IsValidIndex(Handle.GetPoolIndex())) return nullptr;
+
+    // The generation moves on every return and every release, so a match means this is still the same acquisition.
+    const FObjectPool& Pool = ObjectPools[Handle.GetPoolIndex()];
+    const bool bCurrent = Pool.Slots.IsCurrent({ Handle.GetSlotIndex(), Handle.GetGeneration() });
+    return bCurrent ? &Pool.Slots[Handle.GetSlotIndex()] : nullptr;
+}
+
+void ULazyDynamicObjectPoolSubsystem::ReturnSlotToPool(const FPoolSlotRef SlotRef)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ReturnSlotToPool);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Return);
+
+    const UClass* ObjectClass = ObjectPools[SlotRef.PoolIndex].ObjectClass;
+    if (ObjectPools[SlotRef.PoolIndex].Slots[SlotRef.SlotIndex].bReturning)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Ignored return of object of %s from its own deactivation"), *ObjectClass->GetName());
+        return;
+    }
+
+    // Pins the return to this acquisition, deactivation callbacks may return, destroy or re-acquire the object.
+    const uint32 Generation = ObjectPools[SlotRef.PoolIndex].Slots.GetGeneration(SlotRef.SlotIndex);
+    const ELazyPoolSlotState State = ObjectPools[SlotRef.PoolIndex].Slots.GetState(SlotRef.SlotIndex);
+
+    // Deactivate the object, for actors along with their components
+    ObjectPools[SlotRef.PoolIndex].Slots[SlotRef.SlotIndex].bReturning = true;
+    DeactivateSlot(SlotRef.PoolIndex, SlotRef.SlotIndex);
+
+    FObjectPool& Pool = ObjectPools[SlotRef.PoolIndex];
+    Pool.Slots[SlotRef.SlotIndex].bReturning = false;
+    if (!Pool.Slots.IsCurrent({ SlotRef.SlotIndex, Generation }) || Pool.Slots.GetState(SlotRef.SlotIndex) != State)
+    {
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Object of %s left its acquisition during deactivation, return skipped"), *ObjectClass->GetName());
+        return;
+    }
+
+    Pool.Slots.SetState(SlotRef.SlotIndex, ELazyPoolSlotState::Available);
+    Pool.Slots[SlotRef.SlotIndex].LastReturnedTime = GetWorld()->GetTimeSeconds();
+    Pool.Demand.LegacyFreeActors++;
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Returned object to pool for %s"), *ObjectClass->GetName());
+    OnActorAddedToPool.Broadcast();
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPoolSize(const TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->Num() : 0;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPendingPoolGrowth(const TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->PendingGrowth : 0;
+}
+
+const ULazyDynamicObjectPoolSubsystem::FObjectPool* ULazyDynamicObjectPoolSubsystem::FindPool(const UClass* ClassType) const
+{
+    const int32* PoolIndex = PoolIndexByClass.Find(ClassType);
+    return PoolIndex ? &ObjectPools[*PoolIndex] : nullptr;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::FindOrAddPoolIndex(const UClass* ClassType)
+{
+    if (const int32* PoolIndex = PoolIndexByClass.Find(ClassType))
+    {
+        return *PoolIndex;
+    }
+
+    // A recorded profile can only raise the initial size an override asks for.
+    const FObjectPoolClassOverride ClassSettings = Settings->ResolveClassOverride(ClassType);
+    const int32 PoolIndex = ObjectPools.AddDefaulted();
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    Pool.ObjectClass = const_cast<UClass*>(ClassType);
+    Pool.Kind = ClassType->IsChildOf<AActor>() ? EObjectPoolKind::Actor
+        : ClassType->IsChildOf<UActorComponent>() ? EObjectPoolKind::Component : EObjectPoolKind::Object;
+    Pool.InitialSize = FMath::Max(ClassSettings.bOverrideInitialPoolSize ? ClassSettings.InitialPoolSize : 0, GetProfiledInitialSize(ClassType));
+    Pool.MaxSize = ClassSettings.MaxPoolSize;
+    Pool.GrowthFactor = ClassSettings.PoolGrowthFactor;
+    Pool.ShrinkThreshold = ClassSettings.ShrinkThreshold;
+    Pool.MinResidentActors = ClassSettings.MinResidentActors;
+    // Components stay registered where they are and objects have nowhere to park.
+    Pool.ParkingMode = Pool.Kind == EObjectPoolKind::Actor ? ClassSettings.ParkingMode : EPooledActorParkingMode::None;
+    Pool.OverlapMode = ClassSettings.OverlapMode;
+    PoolIndexByClass.Add(ClassType, PoolIndex);
+    return PoolIndex;
+}
+
+void ULazyDynamicObjectPoolSubsystem::GetActorsInSlotList(const FObjectPool& Pool, const FLazyPoolSlotList& List, TArray<AActor*>& OutActors) const
+{
+    OutActors.Reserve(OutActors.Num() + List.Num);
+    for (int32 SlotIndex = List.Head; SlotIndex != INDEX_NONE; SlotIndex = Pool.Slots.GetNext(SlotIndex))
+    {
+        OutActors.Add(Pool.Slots[SlotIndex].GetActor());
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::ActivateSlotActor(const int32 PoolIndex, const int32 SlotIndex)
+{
+    // Component and interface callbacks can run gameplay code that grows the pools, so the plan and components are copied.
+    TInlineComponentArray<UActorComponent*> Components;
+    GatherSlotComponents(PoolIndex, SlotIndex, Components);
+    ActivateActor(ObjectPools[PoolIndex].Slots[SlotIndex].GetActor(), ObjectPools[PoolIndex].ActivationPlan, Components);
+}
+
+void ULazyDynamicObjectPoolSubsystem::GatherSlotComponents(const int32 PoolIndex, const int32 SlotIndex, TInlineComponentArray<UActorComponent*>& OutComponents)
+{
+    TArray<TWeakObjectPtr<UActorComponent>>& Components = ObjectPools[PoolIndex].Slots[SlotIndex].Components;
+    OutComponents.Reserve(Components.Num());
+    for (int32 Index = 0; Index < Components.Num();)
+    {
+        UActorComponent* Component = Components[Index].Get();
+        if (IsValid(Component))
+        {
+            OutComponents.Add(Component);
+            ++Index;
+        }
+        else
+        {
+            Components.RemoveAtSwap(Index);
+        }
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::DeactivateSlot(const int32 PoolIndex, const int32 SlotIndex)
+{
+    UObject* Object = ObjectPools[PoolIndex].Slots[SlotIndex].Object;
+    const FActivationPlan Plan = ObjectPools[PoolIndex].ActivationPlan;
+    switch (ObjectPools[PoolIndex].Kind)
+    {
+    case EObjectPoolKind::Actor:
+        // A materialised projectile either ends with its return or, if its class asks for it, carries on flying as a record.
+        if (const FMaterializedProjectile* Materialized = MaterializedProjectiles.Find(static_cast<const AActor*>(Object)))
+        {
+            if (ProjectileRecords[Materialized->ClassIndex].Config.bDematerializeOnReturn) ResumeProjectileRecord(static_cast<AActor*>(Object));
+            else MaterializedProjectiles.Remove(static_cast<const AActor*>(Object));
+        }
+        DeactivateSlotActor(PoolIndex, SlotIndex);
+        break;
+    case EObjectPoolKind::Component:
+        DeactivatePooledComponent(static_cast<UActorComponent*>(Object), Plan);
+        break;
+    case EObjectPoolKind::Object:
+        if (Plan.bImplementsInterface && IsValid(Object)) IPoolableActorInterface::Execute_OnDeactivateToPool(Object);
+        break;
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::DeactivateSlotActor(const int32 PoolIndex, const int32 SlotIndex)
+{
+    TInlineComponentArray<UActorComponent*> Components;
+    GatherSlotComponents(PoolIndex, SlotIndex, Components);
+    const AActor* Actor = ObjectPools[PoolIndex].Slots[SlotIndex].GetActor();
+    DeactivateActor(ObjectPools[PoolIndex].Slots[SlotIndex].GetActor(), ObjectPools[PoolIndex].ActivationPlan, Components);
+
+    // Unregistered parking is the cold idle tier entered right away, acquiring the actor wakes it the same way.
+    // The deactivation callback may have destroyed the actor and handed its slot to another one.
+    if (ObjectPools[PoolIndex].Slots[SlotIndex].Object == Actor
+        && ObjectPools[PoolIndex].ActivationPlan.ParkingMode == EPooledActorParkingMode::Unregistered
+        && ObjectPools[PoolIndex].Slots[SlotIndex].IdleTier == EPooledActorIdleTier::Warm)
+    {
+        DemoteSlotActor(PoolIndex, SlotIndex, EPooledActorIdleTier::Cold);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::ActivateActor(AActor* Actor, const FActivationPlan Plan, const TArrayView<UActorComponent* const> Components)
+{
+    if (!IsValid(Actor))return;
+
+    Actor->SetActorHiddenInGame(false);
+    if (Plan.bToggleCollision) Actor->SetActorEnableCollision(true);
+    if (Plan.bToggleTick) Actor->SetActorTickEnabled(true);
+
+    // Call a custom reset function if the actor implements it
+    if (Plan.bImplementsInterface)
+    {
+        IPoolableActorInterface::Execute_OnActivateFromPool(Actor);
+        return;
+    }
+
+    for (UActorComponent* Component : Components)
+    {
+        if (!IsValid(Component)) continue;
+
+        // Activate the component for further use
+        Component->Activate(true);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::DeactivateActor(AActor* Actor, const FActivationPlan Plan, const TArrayView<UActorComponent* const> Components)
+{
+    if (!IsValid(Actor))return;
+
+    Actor->SetActorHiddenInGame(true);
+    if (Plan.bToggleCollision) Actor->SetActorEnableCollision(false);
+    if (Plan.bToggleTick) Actor->SetActorTickEnabled(false);
+    if (Plan.ParkingMode == EPooledActorParkingMode::Isolated)
+    {
+        Actor->SetActorLocation(Settings->ParkingLocation, false, nullptr, ETeleportType::ResetPhysics);
+    }
+
+    // Call a custom reset function if the actor implements it
+    if (Plan.bImplementsInterface)
+    {
+        IPoolableActorInterface::Execute_OnDeactivateToPool(Actor);
+        return;
+    }
+
+    for (UActorComponent* Component : Components)
+    {
+        if (!IsValid(Component)) continue;
+
+        // Deactivate the component for further use
+        Component->Deactivate();
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::ActivatePooledComponent(UActorComponent* Component, const FActivationPlan Plan)
+{
+    if (!IsValid(Component)) return;
+
+    if (Plan.bToggleVisibility) CastChecked<USceneComponent>(Component)->SetVisibility(true);
+    Component->Activate(true);
+
+    if (Plan.bImplementsInterface)
+    {
+        IPoolableActorInterface::Execute_OnActivateFromPool(Component);
+    }
+}
+
+void ULazyDynamicObjectPoolSubsystem::DeactivatePooledComponent(UActorComponent* Component, const FActivationPlan Plan)
+{
+    if (!IsValid(Component)) return;
+
+    Component->Deactivate();
+    if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
     {
-        NextShrinkTime = Settings->AutoShrinkInterval;
-        GetWorld()->GetTimerManager().SetTimer(ShrinkTimeProgressTimerHandle, this, &ULazyDynamicObjectPoolSubsystem::CalculateNextShrinkTime, 1, true);
-        GetWorld()->GetTimerManager().SetTimer(AutoShrinkTimerHandle, this, &ULazyDynamicObjectPoolSubsystem::PerformAutoShrink, Settings->AutoShrinkInterval, true);
+        // An idle component must not keep following, or keep alive, whatever it was attached to.
+        SceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+        if (Plan.bToggleVisibility) SceneComponent->SetVisibility(false);
+    }
+
+    if (Plan.bImplementsInterface)
+    {
+        IPoolableActorInterface::Execute_OnDeactivateToPool(Component);
     }
 }
 
-void ULazyDynamicObjectPoolSubsystem::Deinitialize()
+ULazyDynamicObjectPoolSubsystem::FActivationPlan ULazyDynamicObjectPoolSubsystem::GetActivationPlan(const int32 PoolIndex)
 {
-    GetWorld()->GetTimerManager().ClearTimer(AutoShrinkTimerHandle);
-    GetWorld()->GetTimerManager().ClearTimer(ShrinkTimeProgressTimerHandle);
-    Super::Deinitialize();
+    FActivationPlan& Plan = ObjectPools[PoolIndex].ActivationPlan;
+    if (!Plan.bBuilt)
+    {
+        // Collision, tick or visibility the class never has is left alone instead of being switched on by every acquire.
+        const UClass* ObjectClass = ObjectPools[PoolIndex].ObjectClass;
+        Plan.bImplementsInterface = ObjectClass->ImplementsInterface(UPoolableActorInterface::StaticClass());
+        if (const AActor* DefaultActor = Cast<AActor>(ObjectClass->GetDefaultObject()))
+        {
+            Plan.bToggleCollision = DefaultActor->GetActorEnableCollision();
+            Plan.bToggleTick = DefaultActor->PrimaryActorTick.bCanEverTick;
+        }
+        else
+        {
+            // Components tick and stop ticking with their activation.
+            const USceneComponent* DefaultSceneComponent = Cast<USceneComponent>(ObjectClass->GetDefaultObject());
+            Plan.bToggleCollision = false;
+            Plan.bToggleTick = false;
+            Plan.bToggleVisibility = DefaultSceneComponent && DefaultSceneComponent->IsVisible();
+        }
+        Plan.ParkingMode = ObjectPools[PoolIndex].ParkingMode;
+        Plan.OverlapMode = ObjectPools[PoolIndex].OverlapMode;
+        Plan.bBuilt = true;
+    }
+    return Plan;
 }
 
-bool ULazyDynamicObjectPoolSubsystem::CreatePool(TSubclassOf<AActor> ActorClass, int32 InitialSize)
+void ULazyDynamicObjectPoolSubsystem::ProcessIdleTiers()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessIdleTiers);
+
+    const UWorld* World = GetWorld();
+    if (!Settings->bEnableIdleTiers || !IsValid(World)) return;
+
+    const double Now = World->GetTimeSeconds();
+    const double Deadline = FPlatformTime::Seconds() + Settings->IdleTierFrameBudgetMs / 1000.0;
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
+    {
+        // Pooled components stay registered on purpose and objects have nothing to unregister.
+        if (ObjectPools[PoolIndex].Kind != EObjectPoolKind::Actor) continue;
+
+        if (!ProcessIdleTier(PoolIndex, EPooledActorIdleTier::Hibernated, Settings->HibernateAfterIdleTime, &FObjectPool::HibernateCursor, Now, Deadline)) return;
+        if (!ProcessIdleTier(PoolIndex, EPooledActorIdleTier::Cold, Settings->ColdAfterIdleTime, &FObjectPool::ColdCursor, Now, Deadline)) return;
+    }
+}
+
+bool ULazyDynamicObjectPoolSubsystem::ProcessIdleTier(const int32 PoolIndex, const EPooledActorIdleTier TargetTier, const double MinIdleTime,
+    FIdleTierCursor FObjectPool::* Cursor, const double Now, const double Deadline)
 {
-    if (GetPoolSize(ActorClass) > 0) return false;
+    // A cursor slot that was acquired or released since has a new generation, the walk then starts over from the head.
+    auto GetResumeSlot = [this, PoolIndex, Cursor]()
+    {
+        const FObjectPool& Pool = ObjectPools[PoolIndex];
+        const FIdleTierCursor& Resume = Pool.*Cursor;
+        const bool bCursorValid = Pool.Slots.IsValidIndex(Resume.SlotIndex)
+            && Pool.Slots.GetState(Resume.SlotIndex) == ELazyPoolSlotState::Available
+            && Pool.Slots.GetGeneration(Resume.SlotIndex) == Resume.Generation;
+        return bCursorValid ? Pool.Slots.GetNext(Resume.SlotIndex) : Pool.Slots.GetAvailable().Head;
+    };
+
+    int32 SlotIndex = GetResumeSlot();
+    while (SlotIndex != INDEX_NONE)
+    {
+        if (FPlatformTime::Seconds() >= Deadline) return false;
 
-    const int32 PoolSize = (InitialSize > 0) ? InitialSize : Settings->DefaultInitialPoolSize;
-    FObjectPool& NewPool = ObjectPools.Add(ActorClass, FObjectPool());
-    GrowActorPool(NewPool, ActorClass, PoolSize);
+        // The list is ordered by return time, once an actor is too recent to demote so is everything behind it.
+        const FPoolSlot& Slot = ObjectPools[PoolIndex].Slots[SlotIndex];
+        if (Now - Slot.LastReturnedTime < MinIdleTime) break;
 
-    LogPoolOperation(FString::Printf(TEXT("Created actor pool for %s with size %d"), *ActorClass->GetName(), PoolSize), ActorClass);
+        const bool bDemote = Slot.IdleTier < TargetTier;
+        ObjectPools[PoolIndex].*Cursor = { SlotIndex, ObjectPools[PoolIndex].Slots.GetGeneration(SlotIndex) };
+        if (bDemote)
+        {
+            // Demotion runs gameplay code that may acquire or return actors, the walk carries on from the cursor as it now stands.
+            DemoteSlotActor(PoolIndex, SlotIndex, TargetTier);
+            SlotIndex = GetResumeSlot();
+        }
+        else
+        {
+            SlotIndex = ObjectPools[PoolIndex].Slots.GetNext(SlotIndex);
+        }
+    }
     return true;
 }
 
-AActor* ULazyDynamicObjectPoolSubsystem::InitializeActorFromPool(const TSubclassOf<AActor> ActorClass, AActor* NewOwner)
+void ULazyDynamicObjectPoolSubsystem::DemoteSlotActor(const int32 PoolIndex, const int32 SlotIndex, const EPooledActorIdleTier NewTier)
 {
-    FObjectPool* Pool = ObjectPools.Find(ActorClass);
-    if (!Pool)
+    FPoolSlot& Slot = ObjectPools[PoolIndex].Slots[SlotIndex];
+    AActor* Actor = Slot.GetActor();
+    const EPooledActorIdleTier OldTier = Slot.IdleTier;
+    const bool bImplementsInterface = ObjectPools[PoolIndex].ActivationPlan.bImplementsInterface;
+    Slot.IdleTier = NewTier;
+    if (!IsValid(Actor)) return;
+
+    // Unregistering removes render proxies and physics bodies while keeping the components themselves.
+    if (OldTier == EPooledActorIdleTier::Warm)
+    {
+        Actor->UnregisterAllComponents();
+    }
+    if (NewTier == EPooledActorIdleTier::Hibernated)
     {
-        CreatePool(ActorClass);
-        Pool = ObjectPools.Find(ActorClass);
+        // Whatever the class, the actor tick leaves the level's tick lists, component ticks went with the components.
+        Actor->RegisterAllActorTickFunctions(false, false);
+        if (bImplementsInterface) IPoolableActorInterface::Execute_OnHibernateInPool(Actor);
     }
 
-    if (Pool->AvailableObjects.IsEmpty())
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Demoted idle actor %s to tier %s"), *Actor->GetName(), *UEnum::GetValueAsString(NewTier));
+}
+
+void ULazyDynamicObjectPoolSubsystem::WakeSlotActor(const int32 PoolIndex, const int32 SlotIndex)
+{
+    FPoolSlot& Slot = ObjectPools[PoolIndex].Slots[SlotIndex];
+    AActor* Actor = Slot.GetActor();
+    const EPooledActorIdleTier OldTier = Slot.IdleTier;
+    const bool bImplementsInterface = ObjectPools[PoolIndex].ActivationPlan.bImplementsInterface;
+    Slot.IdleTier = EPooledActorIdleTier::Warm;
+    if (!IsValid(Actor)) return;
+
+    Actor->RegisterAllComponents();
+    if (OldTier == EPooledActorIdleTier::Hibernated)
     {
-        const int32 GrowthAmount = FMath::Max(1, FMath::FloorToInt(Pool->InUseObjects.Num() * (Settings->PoolGrowthFactor - 1.0f)));
-        GrowActorPool(*Pool, ActorClass, GrowthAmount);
+        // Registering keeps each tick function's enabled state, activation turns tick back on as usual.
+        Actor->RegisterAllActorTickFunctions(true, false);
+        if (bImplementsInterface) IPoolableActorInterface::Execute_OnWakeFromPool(Actor);
     }
+}
 
-    if (Pool->AvailableObjects.IsEmpty()) return nullptr;
+void ULazyDynamicObjectPoolSubsystem::GrowActorPool(const int32 PoolIndex, const int32 GrowthAmount)
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(GrowActorPool);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Grow);
 
-    AActor* Actor = Cast<AActor>(Pool->AvailableObjects.Pop());
-    if (!IsValid(Actor))
+    const UClass* ObjectClass = ObjectPools[PoolIndex].ObjectClass;
+    const int32 MaxGrowth = GetMaxGrowth(PoolIndex, GrowthAmount);
+
+    if (!IsValid(GetWorld()))
     {
-        LogPoolOperation(FString::Printf(TEXT("Failed to initialize actor from pool for %s"), *ActorClass->GetName()), ActorClass);
-        return nullptr;
+        UE_LOG(LogLazyDynamicObjectPool, Error, TEXT("Failed to grow actor pool: World is null"));
+        return;
     }
 
-    Pool->AccessCount++;
-    if(IsValid(NewOwner)) Actor->SetOwner(NewOwner);
-    LogPoolOperation(FString::Printf(TEXT("Initialized actor from pool for %s"), *ActorClass->GetName()), ActorClass);
-    return Actor;
+    ObjectPools[PoolIndex].Slots.Reserve(ObjectPools[PoolIndex].Num() + MaxGrowth);
+    for (int32 i = 0; i < MaxGrowth; ++i)
+    {
+        if (!SpawnPooledObject(PoolIndex)) return;
+    }
+
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Grew pool for %s by %d objects"), *ObjectClass->GetName(), MaxGrowth);
 }
 
-AActor* ULazyDynamicObjectPoolSubsystem::FinishInitializeActorFromPool(AActor* Actor, const FTransform& NewTransform, bool bSweep, 
-FHitResult OutSweepHitResult, ETeleportType Teleport)
+bool ULazyDynamicObjectPoolSubsystem::SpawnPooledObject(const int32 PoolIndex)
 {
-    if (!IsValid(Actor))
+    bool bSpawned;
+    switch (ObjectPools[PoolIndex].Kind)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Attempted to activate invalid actor from pool"));
-        return nullptr;
+    case EObjectPoolKind::Component: bSpawned = CreatePooledComponent(PoolIndex); break;
+    case EObjectPoolKind::Object: bSpawned = CreatePooledUObject(PoolIndex); break;
+    default: bSpawned = SpawnPooledActor(PoolIndex); break;
     }
 
-    const TSubclassOf<AActor> ActorClass = Actor->GetClass();
-    FObjectPool* Pool = ObjectPools.Find(ActorClass);
-    if (!Pool)
+    if (bSpawned) INC_DWORD_STAT(STAT_LazyObjectPool_Growths);
+    return bSpawned;
+}
+
+bool ULazyDynamicObjectPoolSubsystem::SpawnPooledActor(const int32 PoolIndex)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    const FVector SpawnLocation = ObjectPools[PoolIndex].ParkingMode == EPooledActorParkingMode::Isolated ? Settings->ParkingLocation : FVector::ZeroVector;
+    AActor* NewActor = GetWorld()->SpawnActor<AActor>(ObjectPools[PoolIndex].ObjectClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
+    if (!IsValid(NewActor)) return false;
+    OnActorSpawn.Broadcast();
+
+    // actors are not suppose to be destroyed manually by the actor instead to be released to the pool,
+    // how ever in the case it does happen we want to handle that case.
+    NewActor->OnDestroyed.AddDynamic(this, &ULazyDynamicObjectPoolSubsystem::HandleActorDestroyed);
+
+    // Components the actor leaves inactive after spawning are not the pool's to activate.
+    const FActivationPlan Plan = GetActivationPlan(PoolIndex);
+    TArray<UActorComponent*> Components;
+    if (!Plan.bImplementsInterface)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Attempted to activate actor of type %s from non-existent pool"), *ActorClass->GetName());
-        return Actor;
+        TInlineComponentArray<UActorComponent*> AllComponents;
+        NewActor->GetComponents(AllComponents);
+        for (UActorComponent* Component : AllComponents)
+        {
+            if (IsValid(Component) && Component->IsActive()) Components.Add(Component);
+        }
     }
+    DeactivateActor(NewActor, Plan, Components);
 
-    Pool->InUseObjects.Add(Actor);
+    const int32 SlotIndex = AddPooledObject(PoolIndex, NewActor, MoveTemp(Components));
+    if (Plan.ParkingMode == EPooledActorParkingMode::Unregistered)
+    {
+        DemoteSlotActor(PoolIndex, SlotIndex, EPooledActorIdleTier::Cold);
+    }
+    return true;
+}
 
-    Actor->SetActorTransform(NewTransform, bSweep, &OutSweepHitResult, Teleport);
-    // Activate the actor and its components
-    ActivateActor(Actor);
+bool ULazyDynamicObjectPoolSubsystem::CreatePooledComponent(const int32 PoolIndex)
+{
+    // Outered to the world rather than an actor, so any actor can borrow the component without owning it.
+    UWorld* World = GetWorld();
+    UActorComponent* NewComponent = NewObject<UActorComponent>(World, ObjectPools[PoolIndex].ObjectClass);
+    if (!IsValid(NewComponent)) return false;
 
-    LogPoolOperation(FString::Printf(TEXT("Activated actor from pool for %s"), *ActorClass->GetName()), ActorClass);
-    return Actor;
+    // Registered once and kept registered while idle, that is the cost pooling a component saves.
+    NewComponent->SetAutoActivate(false);
+    NewComponent->RegisterComponentWithWorld(World);
+    OnActorSpawn.Broadcast();
+
+    DeactivatePooledComponent(NewComponent, GetActivationPlan(PoolIndex));
+    AddPooledObject(PoolIndex, NewComponent, TArray<UActorComponent*>());
+    return true;
 }
 
-void ULazyDynamicObjectPoolSubsystem::ReturnActorToPool(AActor* Actor)
+bool ULazyDynamicObjectPoolSubsystem::CreatePooledUObject(const int32 PoolIndex)
 {
-    if (!IsValid(Actor)) return;
+    UObject* NewPooledObject = NewObject<UObject>(this, ObjectPools[PoolIndex].ObjectClass);
+    if (!IsValid(NewPooledObject)) return false;
+    OnActorSpawn.Broadcast();
 
-    const TSubclassOf<AActor> ActorClass = Actor->GetClass();
-    FObjectPool* Pool = ObjectPools.Find(ActorClass);
-    if (!Pool)
+    if (GetActivationPlan(PoolIndex).bImplementsInterface)
     {
-        LogPoolOperation(FString::Printf(TEXT("Attempted to return actor of type %s to non-existent pool"), *ActorClass->GetName()), ActorClass);
-        return;
+        IPoolableActorInterface::Execute_OnDeactivateToPool(NewPooledObject);
     }
+    AddPooledObject(PoolIndex, NewPooledObject, TArray<UActorComponent*>());
+    return true;
+}
 
-    // Deactivate the actor and its components
-    DeactivateActor(Actor);
-
-    Pool->InUseObjects.Remove(Actor);
-    Pool->AvailableObjects.Add(Actor);
+int32 ULazyDynamicObjectPoolSubsystem::AddPooledObject(const int32 PoolIndex, UObject* Object, TArray<UActorComponent*>&& Components)
+{
+    // Creation can run arbitrary BeginPlay or interface code that creates other pools, so the pool is re-fetched by index.
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    if (Pool.ActorResidentBytes == 0)
+    {
+        Pool.ActorResidentBytes = EstimateResidentBytes(Object);
+    }
+    const int32 SlotIndex = Pool.Slots.Emplace();
+    Pool.Slots[SlotIndex].Object = Object;
+    Pool.Slots[SlotIndex].Components.Append(Components);
+    PooledObjectSlots.Add(Object, { PoolIndex, SlotIndex });
+    Pool.TotalGrowthOperations ++;
+    Pool.Demand.LastGrowthTime = GetWorld()->GetTimeSeconds();
+    Pool.Slots[SlotIndex].LastReturnedTime = Pool.Demand.LastGrowthTime;
+    return SlotIndex;
+}
 
-    LogPoolOperation(FString::Printf(TEXT("Returned actor to pool for %s"), *ActorClass->GetName()), ActorClass);
+int32 ULazyDynamicObjectPoolSubsystem::GetMaxGrowth(const int32 PoolIndex, const int32 GrowthAmount) const
+{
+    const FObjectPool& Pool = ObjectPools[PoolIndex];
+    return Pool.MaxSize > 0 ? FMath::Min(GrowthAmount, Pool.MaxSize - Pool.Num()) : GrowthAmount;
 }
 
-int32 ULazyDynamicObjectPoolSubsystem::GetPoolSize(const TSubclassOf<AActor> ClassType) const
+void ULazyDynamicObjectPoolSubsystem::RequestPoolGrowth(const int32 PoolIndex, const int32 GrowthAmount)
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
-    return Pool ? Pool->AvailableObjects.Num() + Pool->InUseObjects.Num() : 0;
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+    const int32 QueuedGrowth = FMath::Max(0, GetMaxGrowth(PoolIndex, Pool.PendingGrowth + GrowthAmount) - Pool.PendingGrowth);
+    Pool.PendingGrowth += QueuedGrowth;
 }
 
-void ULazyDynamicObjectPoolSubsystem::ActivateActor(AActor* Actor)
+void ULazyDynamicObjectPoolSubsystem::UpdatePoolDemand(const float DeltaTime)
 {
-    if (!IsValid(Actor))return;
+    LAZYOBJECTPOOL_TRACE_SCOPE(UpdatePoolDemand);
 
-    Actor->SetActorHiddenInGame(false);
-    Actor->SetActorEnableCollision(true);
-    Actor->SetActorTickEnabled(true);
+    if (DeltaTime <= 0.0f) return;
 
-    // Call a custom reset function if the actor implements it
-    if (Actor->Implements<UPoolableActorInterface>())
+    // Exponential moving average, the weight depends on the frame time so the rate does not depend on the frame rate.
+    const float Alpha = 1.0f - FMath::Exp(-DeltaTime / FMath::Max(Settings->DemandSmoothingTime, UE_KINDA_SMALL_NUMBER));
+    // Growth queued by every pool is charged up front, otherwise a pool evicted down to the budget regrows on the next
+    // demand tick and is evicted again.
+    int64 HeadroomBytes = GetMemoryHeadroomBytes();
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        IPoolableActorInterface::Execute_OnActivateFromPool(Actor);
-        return;
-    }
+        FObjectPool::FPoolDemand& Demand = ObjectPools[PoolIndex].Demand;
+        Demand.AcquisitionRate += Alpha * (Demand.AcquisitionsThisFrame / DeltaTime - Demand.AcquisitionRate);
+        Demand.AcquisitionsThisFrame = 0;
 
-    // Activate and reset components
-    TInlineComponentArray<UActorComponent*> Components;
-    Actor->GetComponents(Components);
+        // Pools that were never filled or were cleared are left alone until someone asks for them again,
+        // and nothing grows ahead of demand past the memory budget.
+        const FObjectPool& Pool = ObjectPools[PoolIndex];
+        if (Pool.Num() == 0 || HeadroomBytes <= 0) continue;
 
-    for (UActorComponent* Component : Components)
-    {
-        if (!IsValid(Component)) continue;
+        int32 DesiredFreeActors = GrowthPolicy->GetDesiredFreeActors(GetDemandStats(PoolIndex));
+        if (Settings->bEnableBudgetedGrowth)
+        {
+            DesiredFreeActors = FMath::Max(DesiredFreeActors, Settings->MinFreeActorsPerPool);
+        }
 
-        // Activate the component for further use
-        Component->Activate(true);
+        int32 Deficit = DesiredFreeActors - (Pool.Slots.GetAvailable().Num + Pool.PendingGrowth);
+        if (Pool.ActorResidentBytes > 0 && HeadroomBytes < MAX_int64)
+        {
+            Deficit = static_cast<int32>(FMath::Min<int64>(Deficit, HeadroomBytes / Pool.ActorResidentBytes));
+            HeadroomBytes -= FMath::Max(Deficit, 0) * Pool.ActorResidentBytes;
+        }
+        if (Deficit <= 0) continue;
+
+        ObjectPools[PoolIndex].Session.GrowthEvents++;
+        if (Settings->bEnableBudgetedGrowth)
+        {
+            RequestPoolGrowth(PoolIndex, Deficit);
+        }
+        else
+        {
+            GrowActorPool(PoolIndex, Deficit);
+        }
     }
 }
 
-void ULazyDynamicObjectPoolSubsystem::DeactivateActor(AActor* Actor)
+void ULazyDynamicObjectPoolSubsystem::ProcessPendingGrowth()
 {
-    if (!IsValid(Actor))return;
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessPendingGrowth);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Grow);
 
-    Actor->SetActorHiddenInGame(true);
-    Actor->SetActorEnableCollision(false);
-    Actor->SetActorTickEnabled(false);
+    if (!IsValid(GetWorld())) return;
 
-    // Call a custom reset function if the actor implements it
-    if (Actor->Implements<UPoolableActorInterface>())
+    TArray<int32, TInlineAllocator<16>> GrowingPools;
+    TArray<int32, TInlineAllocator<16>> SpawnedPerPool;
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        IPoolableActorInterface::Execute_OnDeactivateToPool(Actor);
-        return;
+        if (ObjectPools[PoolIndex].PendingGrowth > 0)
+        {
+            GrowingPools.Add(PoolIndex);
+            SpawnedPerPool.Add(0);
+        }
     }
-    
+    if (GrowingPools.IsEmpty()) return;
 
-    // Deactivate components
-    TInlineComponentArray<UActorComponent*> Components;
-    Actor->GetComponents(Components);
+    const double Deadline = FPlatformTime::Seconds() + Settings->GrowthFrameBudgetMs / 1000.0;
+    do
+    {
+        // Spawn for the highest priority pool, then for the one closest to running dry, measured as free actors per actor in use.
+        int32 BestEntry = INDEX_NONE;
+        int32 BestPriority = TNumericLimits<int32>::Lowest();
+        float BestFreeRatio = TNumericLimits<float>::Max();
+        for (int32 Entry = 0; Entry < GrowingPools.Num(); ++Entry)
+        {
+            const FObjectPool& Pool = ObjectPools[GrowingPools[Entry]];
+            if (Pool.PendingGrowth <= 0) continue;
 
-    for (UActorComponent* Component : Components)
+            const float FreeRatio = static_cast<float>(Pool.Slots.GetAvailable().Num) / static_cast<float>(Pool.Slots.GetNumAcquired() + 1);
+            if (Pool.Priority > BestPriority || (Pool.Priority == BestPriority && FreeRatio < BestFreeRatio))
+            {
+                BestPriority = Pool.Priority;
+                BestFreeRatio = FreeRatio;
+                BestEntry = Entry;
+            }
+        }
+        if (BestEntry == INDEX_NONE) break;
+
+        const int32 PoolIndex = GrowingPools[BestEntry];
+        ObjectPools[PoolIndex].PendingGrowth--;
+        if (GetMaxGrowth(PoolIndex, 1) <= 0)
+        {
+            // The pool reached its size limit through synchronous growth in the meantime.
+            ObjectPools[PoolIndex].PendingGrowth = 0;
+            continue;
+        }
+
+        if (SpawnPooledObject(PoolIndex))
+        {
+            SpawnedPerPool[BestEntry]++;
+        }
+    }
+    while (FPlatformTime::Seconds() < Deadline);
+
+    for (int32 Entry = 0; Entry < GrowingPools.Num(); ++Entry)
     {
-        if (!IsValid(Component)) continue;
+        if (SpawnedPerPool[Entry] == 0) continue;
 
-        // Deactivate the component for further use
-        Component->Deactivate();
+        const UClass* ObjectClass = ObjectPools[GrowingPools[Entry]].ObjectClass;
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Grew pool for %s by %d objects (%d pending)"), *ObjectClass->GetName(),
+            SpawnedPerPool[Entry], ObjectPools[GrowingPools[Entry]].PendingGrowth);
     }
 }
 
-void ULazyDynamicObjectPoolSubsystem::GrowActorPool(FObjectPool& Pool, TSubclassOf<AActor> ActorClass, int32 GrowthAmount)
+void ULazyDynamicObjectPoolSubsystem::ShrinkPool(const int32 PoolIndex)
 {
-    const int32 CurrentSize = Pool.AvailableObjects.Num() + Pool.InUseObjects.Num();
-    const int32 MaxGrowth = Settings->MaxPoolSize > 0 ? FMath::Min(GrowthAmount, Settings->MaxPoolSize - CurrentSize) : GrowthAmount;
+    LAZYOBJECTPOOL_TRACE_SCOPE(ShrinkPool);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Shrink);
 
-    UWorld* World = GetWorld();
-    if (!IsValid(World))
+    FObjectPool& Pool = ObjectPools[PoolIndex];
+
+    // Calculate the total size and target size
+    const int32 TotalSize = Pool.Num();
+    const int32 TargetSize = FMath::Max3(GetInitialSize(PoolIndex), LazyObjectPool::GetThresholdShrinkTarget(TotalSize, Pool.ShrinkThreshold), Pool.MinResidentActors);
+
+    // The policy may keep more than the threshold asks for, never less.
+    const int32 PolicyTargetSize = GrowthPolicy->GetShrinkTarget(GetDemandStats(PoolIndex), TargetSize);
+    int32 NumToRemove = FMath::Min(FMath::Max((Pool.Slots.GetAvailable().Num - TargetSize), 0), FMath::Max(TotalSize - PolicyTargetSize, 0));
+
+    // Free actors the current acquisition rate will hand out soon are kept, destroying them would only cause a respawn.
+    const int32 ExpectedDemand = FMath::CeilToInt(Pool.Demand.AcquisitionRate * Settings->ShrinkDemandLookahead);
+    NumToRemove = FMath::Min(NumToRemove, Pool.Slots.GetAvailable().Num - ExpectedDemand);
+
+    // Peak usage is measured from one shrink pass to the next, the legacy replay shrinks the way the pool used to.
+    Pool.Demand.PeakInUse = Pool.Slots.GetNumAcquired();
+    const int32 LegacyTargetSize = FMath::Max(Settings->DefaultInitialPoolSize,
+        LazyObjectPool::GetThresholdShrinkTarget(Pool.Demand.LegacyFreeActors + Pool.Demand.PeakInUse, Settings->ShrinkThreshold));
+    Pool.Demand.LegacyFreeActors = FMath::Min(Pool.Demand.LegacyFreeActors, LegacyTargetSize);
+
+    // Check if shrinking is necessary, a pool that is still growing is never shrunk
+    if (NumToRemove <= 0 || Pool.PendingGrowth > 0)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to grow actor pool: World is null"));
+        Pool.PendingShrink = 0;
         return;
     }
 
-    for (int32 i = 0; i < MaxGrowth; ++i)
+    // The actors are destroyed over the next frames by ProcessPendingShrink
+    Pool.PendingShrink = NumToRemove;
+    TotalShrinkOperations++;
+
+    // Log the operation
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Queued %d objects for shrinking from pool for %s"), NumToRemove, *Pool.ObjectClass->GetName());
+}
+
+void ULazyDynamicObjectPoolSubsystem::ProcessPendingShrink()
+{
+    LAZYOBJECTPOOL_TRACE_SCOPE(ProcessPendingShrink);
+    SCOPE_CYCLE_COUNTER(STAT_LazyObjectPool_Shrink);
+
+    const UWorld* World = GetWorld();
+    if (!IsValid(World)) return;
+
+    TArray<int32, TInlineAllocator<16>> ShrinkingPools;
+    TArray<int32, TInlineAllocator<16>> DestroyedPerPool;
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
+    {
+        if (ObjectPools[PoolIndex].PendingShrink > 0)
+        {
+            ShrinkingPools.Add(PoolIndex);
+            DestroyedPerPool.Add(0);
+        }
+    }
+    if (ShrinkingPools.IsEmpty()) return;
+
+    const double Deadline = FPlatformTime::Seconds() + Settings->ShrinkFrameBudgetMs / 1000.0;
+    const double IdleCutoff = World->GetTimeSeconds() - Settings->MinIdleTimeBeforeShrink;
+    int32 Entry = 0;
+    int32 NumShrinking = ShrinkingPools.Num();
+    do
     {
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-        AActor* NewActor = World->SpawnActor<AActor>(ActorClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
-        if (!IsValid(NewActor)) return;
-        OnActorSpawn.Broadcast();
+        // Round robin over the pools so one large shrink does not hold back the others.
+        Entry = (Entry + 1) % ShrinkingPools.Num();
+        const int32 PoolIndex = ShrinkingPools[Entry];
+        FObjectPool& Pool = ObjectPools[PoolIndex];
+        if (Pool.PendingShrink <= 0) continue;
+
+        // The head of the available list has been idle the longest, once it is too recent so is everything behind it.
+        // Demand picking up again since the shrink pass also cancels the rest.
+        const int32 SlotIndex = Pool.Slots.GetAvailable().Head;
+        const int32 ExpectedDemand = FMath::CeilToInt(Pool.Demand.AcquisitionRate * Settings->ShrinkDemandLookahead);
+        if (SlotIndex == INDEX_NONE || Pool.Slots[SlotIndex].LastReturnedTime > IdleCutoff
+            || Pool.PendingGrowth > 0 || Pool.Slots.GetAvailable().Num <= ExpectedDemand)
+        {
+            Pool.PendingShrink = 0;
+            NumShrinking--;
+            continue;
+        }
 
-        // actors are not suppose to be destroyed manually by the actor instead to be released to the pool,
-        // how ever in the case it does happen we want to handle that case.
-        NewActor->OnDestroyed.AddDynamic(this, &ULazyDynamicObjectPoolSubsystem::HandleActorDestroyed);
-        DeactivateActor(NewActor);
-        Pool.AvailableObjects.Add(NewActor);
-        Pool.TotalGrowthOperations ++;
+        Pool.PendingShrink--;
+        if (Pool.PendingShrink == 0) NumShrinking--;
+        DestroyPooledObject(PoolIndex, SlotIndex);
+        DestroyedPerPool[Entry]++;
     }
+    while (NumShrinking > 0 && FPlatformTime::Seconds() < Deadline);
 
-    LogPoolOperation(FString::Printf(TEXT("Grew actor pool for %s by %d actors"), *ActorClass->GetName(), MaxGrowth), ActorClass);
+    for (Entry = 0; Entry < ShrinkingPools.Num(); ++Entry)
+    {
+        if (DestroyedPerPool[Entry] == 0) continue;
+
+        const UClass* ObjectClass = ObjectPools[ShrinkingPools[Entry]].ObjectClass;
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Shrunk pool for %s by %d objects (%d pending)"), *ObjectClass->GetName(),
+            DestroyedPerPool[Entry], ObjectPools[ShrinkingPools[Entry]].PendingShrink);
+    }
 }
 
-void ULazyDynamicObjectPoolSubsystem::ShrinkPool(FObjectPool& Pool)
+void ULazyDynamicObjectPoolSubsystem::EnforceMemoryBudget()
 {
-    // Calculate the total size and target size
-    const int32 TotalSize = Pool.AvailableObjects.Num() + Pool.InUseObjects.Num();
-    const int32 TargetSize = FMath::Max(Settings->DefaultInitialPoolSize, FMath::CeilToInt(TotalSize * (1.0f - Settings->ShrinkThreshold)));
+    LAZYOBJECTPOOL_TRACE_SCOPE(EnforceMemoryBudget);
 
-    // Check if shrinking is necessary
-    const int32 NumToRemove = FMath::Max((Pool.AvailableObjects.Num() - TargetSize), 0);
-    if (NumToRemove <= 0) return;
+    if (Settings->MemoryBudgetMB <= 0) return;
 
-    const UWorld* World = GetWorld();
-    if (!IsValid(World))
+    const int64 BudgetBytes = static_cast<int64>(Settings->MemoryBudgetMB) * 1024 * 1024;
+    int64 ResidentBytes = GetTotalResidentBytes();
+    if (ResidentBytes <= BudgetBytes) return;
+
+    TMap<int32, int32> EvictedPerPool;
+    const double Deadline = FPlatformTime::Seconds() + Settings->ShrinkFrameBudgetMs / 1000.0;
+    do
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to shrink actor pool: World is null"));
-        return;
+        const int32 PoolIndex = FindEvictionCandidate();
+        if (PoolIndex == INDEX_NONE) break;
+
+        // Queued growth would only be evicted again.
+        FObjectPool& Pool = ObjectPools[PoolIndex];
+        Pool.PendingGrowth = 0;
+        ResidentBytes -= Pool.ActorResidentBytes;
+        DestroyPooledObject(PoolIndex, Pool.Slots.GetAvailable().Head);
+        EvictedPerPool.FindOrAdd(PoolIndex)++;
+    }
+    while (ResidentBytes > BudgetBytes && FPlatformTime::Seconds() < Deadline);
+
+    for (const TPair<int32, int32>& Evicted : EvictedPerPool)
+    {
+        const UClass* ObjectClass = ObjectPools[Evicted.Key].ObjectClass;
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Evicted %d idle objects from pool for %s to stay within the memory budget (%lld bytes resident)"),
+            Evicted.Value, *ObjectClass->GetName(), ResidentBytes);
+    }
+}
+
+int64 ULazyDynamicObjectPoolSubsystem::GetMemoryHeadroomBytes() const
+{
+    if (Settings->MemoryBudgetMB <= 0) return MAX_int64;
+
+    int64 HeadroomBytes = static_cast<int64>(Settings->MemoryBudgetMB) * 1024 * 1024 - GetTotalResidentBytes();
+    for (const FObjectPool& Pool : ObjectPools)
+    {
+        HeadroomBytes -= Pool.ActorResidentBytes * Pool.PendingGrowth;
     }
+    return HeadroomBytes;
+}
 
-    // Remove actors
-    int32 ActuallyRemoved = 0;
-    for (int32 i = 0; i < NumToRemove; ++i)
+int32 ULazyDynamicObjectPoolSubsystem::FindEvictionCandidate() const
+{
+    // The worst pool is the one holding the most bytes per actor for the fewest acquisitions per second.
+    int32 BestPoolIndex = INDEX_NONE;
+    double BestCostPerReuse = 0.0;
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        if (Pool.AvailableObjects.Num() == 0) break;
+        const FObjectPool& Pool = ObjectPools[PoolIndex];
+        if (Pool.Slots.GetAvailable().Num == 0 || Pool.Num() <= Pool.MinResidentActors || Pool.ActorResidentBytes <= 0) continue;
+
+        const double CostPerReuse = static_cast<double>(Pool.ActorResidentBytes) / (Pool.Demand.AcquisitionRate + 0.01);
+        if (CostPerReuse > BestCostPerReuse)
+        {
+            BestCostPerReuse = CostPerReuse;
+            BestPoolIndex = PoolIndex;
+        }
+    }
+    return BestPoolIndex;
+}
+
+int64 ULazyDynamicObjectPoolSubsystem::EstimateResidentBytes(UObject* Object) const
+{
+    // Only memory owned by the instance counts, shared assets such as meshes stay loaded when the object is evicted.
+    FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+    Object->GetResourceSizeEx(ResourceSize);
+    int64 ObjectBytes = Object->GetClass()->GetStructureSize();
 
-        AActor* ActorToRemove = Pool.AvailableObjects.Pop(false);
-        if (ensure(ActorToRemove))
+    // AActor::GetResourceSizeEx already adds what its components own, only their own size is left to count.
+    if (const AActor* Actor = Cast<AActor>(Object))
+    {
+        TInlineComponentArray<UActorComponent*> Components;
+        Actor->GetComponents(Components);
+        for (const UActorComponent* Component : Components)
         {
-            ActorToRemove->Destroy();
-            ++ActuallyRemoved;
-            OnActorDestroy.Broadcast();
+            if (!IsValid(Component)) continue;
+
+            ObjectBytes += Component->GetClass()->GetStructureSize();
         }
     }
 
-    // Shrink the array to avoid unnecessary memory usage
-    Pool.AvailableObjects.Shrink();
+    return ObjectBytes + static_cast<int64>(ResourceSize.GetTotalMemoryBytes());
+}
+
+void ULazyDynamicObjectPoolSubsystem::DestroyPooledObject(const int32 PoolIndex, const int32 SlotIndex)
+{
+    UObject* Object = ObjectPools[PoolIndex].Slots[SlotIndex].Object;
+    const EObjectPoolKind Kind = ObjectPools[PoolIndex].Kind;
+    PooledObjectSlots.Remove(Object);
+    ObjectPools[PoolIndex].Slots.SetState(SlotIndex, ELazyPoolSlotState::Available);
+    ObjectPools[PoolIndex].Slots.Release(SlotIndex);
+    if (!IsValid(Object)) return;
 
-    // Update stats
-    TotalShrinkOperations++;
+    INC_DWORD_STAT(STAT_LazyObjectPool_Destroys);
 
-    // Log the operation
-    LogPoolOperation(FString::Printf(TEXT("Shrunk actor pool by %d actors (attempted %d)"), ActuallyRemoved, NumToRemove), AActor::StaticClass());
+    switch (Kind)
+    {
+    case EObjectPoolKind::Actor:
+        {
+            // The slot is already released, we don't want HandleActorDestroyed to process it a second time.
+            AActor* Actor = static_cast<AActor*>(Object);
+            Actor->OnDestroyed.RemoveDynamic(this, &ULazyDynamicObjectPoolSubsystem::HandleActorDestroyed);
+            Actor->Destroy();
+            break;
+        }
+    case EObjectPoolKind::Component:
+        static_cast<UActorComponent*>(Object)->DestroyComponent();
+        break;
+    case EObjectPoolKind::Object:
+        Object->MarkAsGarbage();
+        break;
+    }
+    OnActorDestroy.Broadcast();
 }
 
 void ULazyDynamicObjectPoolSubsystem::PerformAutoShrink()
 {
-    for (auto& Pair : ObjectPools)
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        ShrinkPool(Pair.Value);
-        LogPoolOperation(FString::Printf(TEXT("Auto-shrunk pool for %s"), *Pair.Key->GetName()), Pair.Key);
+        ShrinkPool(PoolIndex);
+        UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Auto-shrunk pool for %s"), *ObjectPools[PoolIndex].ObjectClass->GetName());
     }
 }
 
@@ -268,27 +2633,40 @@ void ULazyDynamicObjectPoolSubsystem::HandleActorDestroyed(AActor* DestroyedActo
 {
     // Handles the case where an actor is destroyed instead of returned to the pool
     const TSubclassOf<AActor> ActorClass = DestroyedActor->GetClass();
-    FObjectPool* Pool = ObjectPools.Find(ActorClass);
-    
-    if (!Pool)
+    MaterializedProjectiles.Remove(DestroyedActor);
+
+    FPoolSlotRef SlotRef;
+    if (!PooledObjectSlots.RemoveAndCopyValue(DestroyedActor, SlotRef))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Attempted to handle destruction of actor of type %s not managed by any pool"), *ActorClass->GetName());
+        UE_LOG(LogLazyDynamicObjectPool, Warning, TEXT("Attempted to handle destruction of actor of type %s not managed by any pool"), *ActorClass->GetName());
         return;
     }
 
-    Pool->InUseObjects.Remove(DestroyedActor);
-    Pool->AvailableObjects.Remove(DestroyedActor);
+    // The actor may have been destroyed while acquired, its slot goes back before it is released.
+    ObjectPools[SlotRef.PoolIndex].Slots.SetState(SlotRef.SlotIndex, ELazyPoolSlotState::Available);
+    ObjectPools[SlotRef.PoolIndex].Slots.Release(SlotRef.SlotIndex);
     OnActorDestroy.Broadcast();
 
-    LogPoolOperation(FString::Printf(TEXT("Handled destruction of actor from pool for %s"), *ActorClass->GetName()), ActorClass);
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Handled destruction of actor from pool for %s"), *ActorClass->GetName());
 }
 
-void ULazyDynamicObjectPoolSubsystem::LogPoolOperation(const FString& Operation, const TSubclassOf<AActor> ClassType) const
+
+void ULazyDynamicObjectPoolSubsystem::UpdateTraceCounters()
 {
-    if (Settings->bEnableDetailedLogging)
+#if LAZYOBJECTPOOL_TRACE_ENABLED && COUNTERSTRACE_ENABLED
+    if (!LAZYOBJECTPOOL_TRACE_IS_ENABLED()) return;
+
+    for (FObjectPool& Pool : ObjectPools)
     {
-        UE_LOG(LogTemp, Log, TEXT("%s - Class: %s"), *Operation, *ClassType->GetName());
+        if (!Pool.ObjectClass) continue;
+
+        if (!Pool.TraceCounters.IsValid())
+        {
+            Pool.TraceCounters = MakeUnique<FLazyObjectPoolTraceCounters>(Pool.ObjectClass);
+        }
+        Pool.TraceCounters->Set(Pool.Slots.GetAvailable().Num, Pool.Slots.GetNumAcquired());
     }
+#endif
 }
 
 void ULazyDynamicObjectPoolSubsystem::CalculateNextShrinkTime()
@@ -302,39 +2680,60 @@ void ULazyDynamicObjectPoolSubsystem::CalculateNextShrinkTime()
 
 TArray<AActor*> ULazyDynamicObjectPoolSubsystem::GetAvailableActorsInPool(TSubclassOf<AActor> ClassType) const
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
-    return Pool ? Pool->AvailableObjects : TArray<AActor*>();
+    TArray<AActor*> Actors;
+    if (const FObjectPool* Pool = FindPool(ClassType))
+    {
+        GetActorsInSlotList(*Pool, Pool->Slots.GetAvailable(), Actors);
+    }
+    return Actors;
 }
 
 TArray<AActor*> ULazyDynamicObjectPoolSubsystem::GetInUseActorsInPool(TSubclassOf<AActor> ClassType) const
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
-    return Pool ? Pool->InUseObjects : TArray<AActor*>();
+    TArray<AActor*> Actors;
+    if (const FObjectPool* Pool = FindPool(ClassType))
+    {
+        GetActorsInSlotList(*Pool, Pool->Slots.GetInUse(), Actors);
+    }
+    return Actors;
 }
 
 TArray<AActor*> ULazyDynamicObjectPoolSubsystem::GetAllActorsInPool(TSubclassOf<AActor> ClassType) const
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
+    const FObjectPool* Pool = FindPool(ClassType);
     if (!Pool) return TArray<AActor*>();
 
-    TArray<AActor*> AllActors = Pool->AvailableObjects;
-    AllActors.Append(Pool->InUseObjects);
+    TArray<AActor*> AllActors;
+    AllActors.Reserve(Pool->Num());
+    for (int32 SlotIndex = 0; SlotIndex < Pool->Slots.GetMaxIndex(); ++SlotIndex)
+    {
+        if (Pool->Slots.GetState(SlotIndex) != ELazyPoolSlotState::Empty)
+        {
+            AllActors.Add(Pool->Slots[SlotIndex].GetActor());
+        }
+    }
     return AllActors;
 }
 
 TArray<TSubclassOf<AActor>> ULazyDynamicObjectPoolSubsystem::GetAllPooledClasses() const
 {
     TArray<TSubclassOf<AActor>> Classes;
-    ObjectPools.GetKeys(Classes);
+    for (const FObjectPool& Pool : ObjectPools)
+    {
+        if (Pool.Kind == EObjectPoolKind::Actor && Pool.Num() > 0)
+        {
+            Classes.Add(Pool.ObjectClass);
+        }
+    }
     return Classes;
 }
 
 int32 ULazyDynamicObjectPoolSubsystem::GetTotalActorsInAllPools() const
 {
     int32 TotalActors = 0;
-    for (const auto& Pair : ObjectPools)
+    for (const FObjectPool& Pool : ObjectPools)
     {
-        TotalActors += Pair.Value.AvailableObjects.Num() + Pair.Value.InUseObjects.Num();
+        TotalActors += Pool.Num();
     }
     return TotalActors;
 }
@@ -344,53 +2743,132 @@ int32 ULazyDynamicObjectPoolSubsystem::GetMaximumPoolSize() const
     return Settings ? Settings->MaxPoolSize : 0;
 }
 
-int32 ULazyDynamicObjectPoolSubsystem::GetPoolAccessCount(TSubclassOf<AActor> ClassType) const
+int32 ULazyDynamicObjectPoolSubsystem::GetMaximumPoolSizeForClass(TSubclassOf<UObject> ClassType) const
+{
+    if (const FObjectPool* Pool = FindPool(ClassType))
+    {
+        return Pool->MaxSize;
+    }
+    return Settings && ClassType ? Settings->ResolveClassOverride(ClassType).MaxPoolSize : GetMaximumPoolSize();
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPoolAccessCount(TSubclassOf<UObject> ClassType) const
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
+    const FObjectPool* Pool = FindPool(ClassType);
     return Pool ? Pool->AccessCount : 0;
 }
 
-int32 ULazyDynamicObjectPoolSubsystem::GetPoolGrowthOperation(TSubclassOf<AActor> ClassType) const
+int32 ULazyDynamicObjectPoolSubsystem::GetPendingPoolShrink(TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->PendingShrink : 0;
+}
+
+int64 ULazyDynamicObjectPoolSubsystem::GetActorResidentBytes(TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->ActorResidentBytes : 0;
+}
+
+int64 ULazyDynamicObjectPoolSubsystem::GetPoolResidentBytes(TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->ActorResidentBytes * Pool->Num() : 0;
+}
+
+int64 ULazyDynamicObjectPoolSubsystem::GetTotalResidentBytes() const
+{
+    int64 TotalBytes = 0;
+    for (const FObjectPool& Pool : ObjectPools)
+    {
+        TotalBytes += Pool.ActorResidentBytes * Pool.Num();
+    }
+    return TotalBytes;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetNumIdleActorsInTier(TSubclassOf<AActor> ClassType, const EPooledActorIdleTier Tier) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    if (!Pool) return 0;
+
+    int32 NumInTier = 0;
+    for (int32 SlotIndex = Pool->Slots.GetAvailable().Head; SlotIndex != INDEX_NONE; SlotIndex = Pool->Slots.GetNext(SlotIndex))
+    {
+        if (Pool->Slots[SlotIndex].IdleTier == Tier) NumInTier++;
+    }
+    return NumInTier;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPoolMissCount(TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? Pool->Demand.NumMisses : 0;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPoolMissesAvoided(TSubclassOf<UObject> ClassType) const
 {
-    const FObjectPool* Pool = ObjectPools.Find(ClassType);
+    const FObjectPool* Pool = FindPool(ClassType);
+    return Pool ? FMath::Max(0, Pool->Demand.NumLegacyMisses - Pool->Demand.NumMisses) : 0;
+}
+
+int32 ULazyDynamicObjectPoolSubsystem::GetPoolGrowthOperation(TSubclassOf<UObject> ClassType) const
+{
+    const FObjectPool* Pool = FindPool(ClassType);
     return Pool ? Pool->TotalGrowthOperations : 0;
 }
 
 void ULazyDynamicObjectPoolSubsystem::ClearAllPools()
 {
-    for (auto& Pair : ObjectPools)
+    // Pools keep their index and slot generations so anything still referring to them stays safe to validate.
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        FObjectPool& Pool = Pair.Value;
-        for (AActor* Actor : Pool.AvailableObjects)
-        {
-            if (IsValid(Actor))
-            {
-                Actor->Destroy();
-            }
-        }
-        for (AActor* Actor : Pool.InUseObjects)
+        for (int32 SlotIndex = 0; SlotIndex < ObjectPools[PoolIndex].Slots.GetMaxIndex(); ++SlotIndex)
         {
-            if (IsValid(Actor))
+            if (ObjectPools[PoolIndex].Slots.GetState(SlotIndex) != ELazyPoolSlotState::Empty)
             {
-                Actor->Destroy();
+                DestroyPooledObject(PoolIndex, SlotIndex);
             }
         }
-        Pool.AvailableObjects.Empty();
-        Pool.InUseObjects.Empty();
+
+        FObjectPool& Pool = ObjectPools[PoolIndex];
+        Pool.PendingGrowth = 0;
+        Pool.PendingShrink = 0;
         Pool.AccessCount = 0;
         Pool.TotalGrowthOperations = 0;
+        Pool.Demand = FObjectPool::FPoolDemand();
     }
-    ObjectPools.Empty();
-    LogPoolOperation(TEXT("Cleared all pools"), AActor::StaticClass());
+    MaterializedProjectiles.Reset();
+
+    // Records and dehydrated actors would otherwise come back as actors of the rebuilt pools. Dropping a record bumps its
+    // generation, so projectile handles still held go stale.
+    for (int32 ClassIndex = 0; ClassIndex < ProjectileRecords.Num(); ++ClassIndex)
+    {
+        for (int32 Record = ProjectileRecords[ClassIndex].Num() - 1; Record >= 0; --Record)
+        {
+            RemoveProjectileRecord(ClassIndex, Record);
+        }
+        SyncProjectileRenderer(ClassIndex);
+    }
+    for (FDehydratedActors& Dehydrated : DehydratedActors)
+    {
+        Dehydrated.Transforms.Reset();
+        Dehydrated.States.Reset();
+        Dehydrated.OriginalActors.Reset();
+        if (IsValid(Dehydrated.Renderer)) Dehydrated.Renderer->ClearInstances();
+    }
+
+    // Queued requests were counted against the pools just emptied.
+    AbandonAsyncAcquires();
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Cleared all pools"));
 }
 
 void ULazyDynamicObjectPoolSubsystem::ShrinkAllPools()
 {
-    for (auto& Pair : ObjectPools)
+    for (int32 PoolIndex = 0; PoolIndex < ObjectPools.Num(); ++PoolIndex)
     {
-        ShrinkPool(Pair.Value);
+        ShrinkPool(PoolIndex);
     }
-    LogPoolOperation(TEXT("Shrunk all pools"), AActor::StaticClass());
+    UE_LOG(LogLazyDynamicObjectPool, Verbose, TEXT("Shrunk all pools"));
 }
 
 float ULazyDynamicObjectPoolSubsystem::GetTotalActorsInPoolRatio()
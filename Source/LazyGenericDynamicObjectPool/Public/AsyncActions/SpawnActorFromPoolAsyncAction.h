@@ -0,0 +1,53 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "SpawnActorFromPoolAsyncAction.generated.h"
+
+class ULazyDynamicObjectPoolSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSpawnActorFromPoolAsyncCompleted, AActor*, Actor);
+
+/**
+ * @class USpawnActorFromPoolAsyncAction
+ * @brief Proxy behind the "Spawn Actor From Pool (Async)" node, waits on the subsystem for a reserved actor.
+ */
+UCLASS(MinimalAPI)
+class USpawnActorFromPoolAsyncAction : public UBlueprintAsyncActionBase
+{
+    GENERATED_BODY()
+
+public:
+    /** Fired with the reserved actor, which has to be finished from the handler. If it is not, it goes back to the pool. */
+    UPROPERTY(BlueprintAssignable)
+    FOnSpawnActorFromPoolAsyncCompleted OnSpawned;
+
+    /** Fired with null when the timeout ran out, the class was not valid, the world context was destroyed or the world was torn down. */
+    UPROPERTY(BlueprintAssignable)
+    FOnSpawnActorFromPoolAsyncCompleted OnFailed;
+
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (WorldContext = "WorldContextObject", BlueprintInternalUseOnly = "true"))
+    static USpawnActorFromPoolAsyncAction* InitializeActorFromPoolAsync(UObject* WorldContextObject, TSubclassOf<AActor> ActorClass,
+        AActor* Owner, float Timeout, int32 Priority);
+
+    virtual void Activate() override;
+
+private:
+    void Complete(AActor* Actor);
+
+    UPROPERTY()
+    UObject* WorldContextObject = nullptr;
+
+    UPROPERTY()
+    TSubclassOf<AActor> ActorClass;
+
+    UPROPERTY()
+    AActor* Owner = nullptr;
+
+    TWeakObjectPtr<ULazyDynamicObjectPoolSubsystem> Subsystem;
+
+    float Timeout = 0.0f;
+    int32 Priority = 0;
+};
@@ -0,0 +1,417 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @enum ELazyPoolSlotState
+ * @brief Lifecycle of one slot in a TLazyObjectPool.
+ */
+enum class ELazyPoolSlotState : uint8
+{
+    /** Holds nothing and waits on the free-list to be reused. */
+    Empty,
+    /** Holds an idle item that can be acquired. */
+    Available,
+    /** Acquired, but not yet handed over to whoever acquired it. */
+    Reserved,
+    /** Acquired and handed over. */
+    InUse
+};
+
+/**
+ * @struct FLazyPoolSlotList
+ * @brief Intrusive list threaded through the slots of one state, the head is the slot that entered it first.
+ */
+struct FLazyPoolSlotList
+{
+    int32 Head = INDEX_NONE;
+    int32 Tail = INDEX_NONE;
+    int32 Num = 0;
+};
+
+/**
+ * @struct FLazyObjectPoolDefaultPolicy
+ * @brief Items live in one array, the pool grows and shrinks the way the actor pools do by default.
+ *
+ * A policy is a plain struct of compile-time constants, derive from this one and override what differs.
+ */
+struct FLazyObjectPoolDefaultPolicy
+{
+    /** Store items in fixed size blocks that never move, instead of one array that reallocates as the pool grows. */
+    static constexpr bool bUseArena = false;
+    static constexpr int32 ArenaBlockSize = 64;
+
+    /** Number of items an empty pool is filled with on its first acquire. */
+    static constexpr int32 InitialSize = 10;
+    /** A pool that runs dry grows by this factor of what is in use. */
+    static constexpr float GrowthFactor = 1.5f;
+    /** Fraction of the pool Shrink lets go of, idle items permitting. */
+    static constexpr float ShrinkThreshold = 0.25f;
+    /** Upper bound on the number of live items, 0 is unlimited. */
+    static constexpr int32 MaxSize = 0;
+};
+
+/**
+ * @struct FLazyObjectPoolArenaPolicy
+ * @brief Items are constructed in place inside contiguous blocks, so pointers to them stay valid while the pool grows.
+ * @note Meant for plain C++ types such as projectile state or path requests. Items of empty slots are destroyed.
+ */
+struct FLazyObjectPoolArenaPolicy : FLazyObjectPoolDefaultPolicy
+{
+    static constexpr bool bUseArena = true;
+};
+
+namespace LazyObjectPool
+{
+    /** Items a pool with NumInUse acquired items grows by when it runs dry. */
+    inline int32 GetFactorGrowth(const int32 NumInUse, const float GrowthFactor)
+    {
+        return FMath::FloorToInt(NumInUse * (GrowthFactor - 1.0f));
+    }
+
+    /** Size a pool of TotalSize items shrinks down to. */
+    inline int32 GetThresholdShrinkTarget(const int32 TotalSize, const float ShrinkThreshold)
+    {
+        return FMath::CeilToInt(TotalSize * (1.0f - ShrinkThreshold));
+    }
+}
+
+/**
+ * @class TLazyObjectPool
+ * @brief Slot table behind every pool: a free-list of empty slots and intrusive lists of available and in-use ones.
+ *
+ * Every state change is O(1) and a slot index stays valid for as long as the slot holds its item. Each slot carries a
+ * generation that advances whenever it stops being acquired or is released, so a slot index and generation pair taken
+ * at acquire time goes stale as soon as the item is returned.
+ *
+ * Has no dependency on UObjects or a world. Owners that create items themselves, such as the actor subsystem, use
+ * Emplace, SetState and Release directly. Plain C++ types can let Acquire, Return and Shrink handle growth through the policy.
+ */
+template<typename T, typename Policy = FLazyObjectPoolDefaultPolicy>
+class TLazyObjectPool
+{
+    static_assert(!Policy::bUseArena || Policy::ArenaBlockSize > 0, "Arena pools need a positive block size");
+
+public:
+    using ElementType = T;
+
+    /** One acquisition of an item, stale once the item is returned. */
+    struct FHandle
+    {
+        int32 SlotIndex = INDEX_NONE;
+        uint32 Generation = 0;
+
+        bool IsSet() const { return SlotIndex != INDEX_NONE; }
+    };
+
+    TLazyObjectPool() = default;
+    ~TLazyObjectPool() { Empty(); }
+
+    TLazyObjectPool(const TLazyObjectPool&) = delete;
+    TLazyObjectPool& operator=(const TLazyObjectPool&) = delete;
+
+    TLazyObjectPool(TLazyObjectPool&& Other) { *this = MoveTemp(Other); }
+    TLazyObjectPool& operator=(TLazyObjectPool&& Other)
+    {
+        if (this != &Other)
+        {
+            Empty();
+            Headers = MoveTemp(Other.Headers);
+            Items = MoveTemp(Other.Items);
+            Blocks = MoveTemp(Other.Blocks);
+            AvailableSlots = Other.AvailableSlots;
+            InUseSlots = Other.InUseSlots;
+            FirstEmptySlot = Other.FirstEmptySlot;
+            NumReserved = Other.NumReserved;
+            Other.ResetLists();
+        }
+        return *this;
+    }
+
+    /** Adds an item in a new or recycled slot, available for acquisition. */
+    template<typename... ArgTypes>
+    int32 Emplace(ArgTypes&&... Args)
+    {
+        int32 SlotIndex = FirstEmptySlot;
+        if (SlotIndex != INDEX_NONE)
+        {
+            FirstEmptySlot = Headers[SlotIndex].Next;
+        }
+        else
+        {
+            SlotIndex = Headers.AddDefaulted();
+            if constexpr (Policy::bUseArena)
+            {
+                if (SlotIndex % Policy::ArenaBlockSize == 0)
+                {
+                    Blocks.AddDefaulted_GetRef().SetNumUninitialized(Policy::ArenaBlockSize);
+                }
+            }
+            else
+            {
+                Items.AddDefaulted();
+            }
+        }
+
+        if constexpr (Policy::bUseArena)
+        {
+            new (GetArenaItem(SlotIndex)) T(Forward<ArgTypes>(Args)...);
+        }
+        else
+        {
+            Items[SlotIndex] = T(Forward<ArgTypes>(Args)...);
+        }
+
+        Headers[SlotIndex].Prev = INDEX_NONE;
+        Headers[SlotIndex].Next = INDEX_NONE;
+        SetState(SlotIndex, ELazyPoolSlotState::Available);
+        return SlotIndex;
+    }
+
+    /**
+     * Drops the item of an available slot and puts the slot on the free-list. Acquired items are set back to available first.
+     * @return False, without touching the slot, if it is not available. Releasing a slot twice would put it on the free-list twice.
+     */
+    bool Release(const int32 SlotIndex)
+    {
+        if (Headers[SlotIndex].State != ELazyPoolSlotState::Available) return false;
+
+        SetState(SlotIndex, ELazyPoolSlotState::Empty);
+
+        // Also advances for an idle item, so a slot index and generation pair never outlives the item it was taken for.
+        Headers[SlotIndex].Generation++;
+
+        if constexpr (Policy::bUseArena)
+        {
+            DestructItem(GetArenaItem(SlotIndex));
+        }
+        else
+        {
+            Items[SlotIndex] = T();
+        }
+
+        Headers[SlotIndex].Next = FirstEmptySlot;
+        FirstEmptySlot = SlotIndex;
+        return true;
+    }
+
+    /** Moves a slot between the available, reserved and in-use states. Use Release to empty it. */
+    void SetState(const int32 SlotIndex, const ELazyPoolSlotState NewState)
+    {
+        FSlotHeader& Header = Headers[SlotIndex];
+        if (Header.State == NewState) return;
+
+        if (FLazyPoolSlotList* OldList = GetSlotList(Header.State))
+        {
+            Unlink(*OldList, SlotIndex);
+        }
+        else if (Header.State == ELazyPoolSlotState::Reserved)
+        {
+            NumReserved--;
+        }
+
+        if (IsAcquiredState(Header.State) && !IsAcquiredState(NewState))
+        {
+            Header.Generation++;
+        }
+        Header.State = NewState;
+
+        if (FLazyPoolSlotList* NewList = GetSlotList(NewState))
+        {
+            LinkTail(*NewList, SlotIndex);
+        }
+        else if (NewState == ELazyPoolSlotState::Reserved)
+        {
+            NumReserved++;
+        }
+    }
+
+    /** Acquires the most recently returned item, growing the pool by the policy when none is available. */
+    FHandle Acquire()
+    {
+        if (AvailableSlots.Num == 0)
+        {
+            const int32 GrowthAmount = Num() == 0
+                ? Policy::InitialSize
+                : LazyObjectPool::GetFactorGrowth(GetNumAcquired(), Policy::GrowthFactor);
+            Grow(FMath::Max(1, GrowthAmount));
+            if (AvailableSlots.Num == 0) return FHandle();
+        }
+
+        const int32 SlotIndex = AvailableSlots.Tail;
+        SetState(SlotIndex, ELazyPoolSlotState::InUse);
+        return { SlotIndex, Headers[SlotIndex].Generation };
+    }
+
+    /** Returns an acquired item, a stale handle is ignored. */
+    bool Return(const FHandle Handle)
+    {
+        if (!IsCurrent(Handle)) return false;
+
+        SetState(Handle.SlotIndex, ELazyPoolSlotState::Available);
+        return true;
+    }
+
+    /** Adds up to Count default constructed items, bounded by the policy's maximum size. Returns how many were added. */
+    int32 Grow(const int32 Count)
+    {
+        const int32 NumToAdd = Policy::MaxSize > 0 ? FMath::Min(Count, Policy::MaxSize - Num()) : Count;
+        for (int32 i = 0; i < NumToAdd; ++i)
+        {
+            Emplace();
+        }
+        return FMath::Max(NumToAdd, 0);
+    }
+
+    /** Releases the longest idle items down to the policy's shrink target, never below its initial size. Returns how many were released. */
+    int32 Shrink()
+    {
+        const int32 TargetSize = FMath::Max(Policy::InitialSize, LazyObjectPool::GetThresholdShrinkTarget(Num(), Policy::ShrinkThreshold));
+        int32 NumReleased = 0;
+        while (Num() > TargetSize && AvailableSlots.Num > 0)
+        {
+            Release(AvailableSlots.Head);
+            NumReleased++;
+        }
+        return NumReleased;
+    }
+
+    /** Releases every slot and frees the storage. */
+    void Empty()
+    {
+        if constexpr (Policy::bUseArena)
+        {
+            for (int32 SlotIndex = 0; SlotIndex < Headers.Num(); ++SlotIndex)
+            {
+                if (Headers[SlotIndex].State != ELazyPoolSlotState::Empty) DestructItem(GetArenaItem(SlotIndex));
+            }
+        }
+        Headers.Empty();
+        Items.Empty();
+        Blocks.Empty();
+        ResetLists();
+    }
+
+    T& operator[](const int32 SlotIndex)
+    {
+        checkSlow(IsValidIndex(SlotIndex));
+        if constexpr (Policy::bUseArena) return *GetArenaItem(SlotIndex);
+        else return Items[SlotIndex];
+    }
+    const T& operator[](const int32 SlotIndex) const
+    {
+        return const_cast<TLazyObjectPool&>(*this)[SlotIndex];
+    }
+
+    /** The item of a handle, or null once the handle went stale. */
+    T* Get(const FHandle Handle) { return IsCurrent(Handle) ? &(*this)[Handle.SlotIndex] : nullptr; }
+
+    bool IsValidIndex(const int32 SlotIndex) const { return Headers.IsValidIndex(SlotIndex); }
+    bool IsAcquired(const int32 SlotIndex) const { return IsAcquiredState(Headers[SlotIndex].State); }
+    bool IsCurrent(const FHandle Handle) const
+    {
+        return IsValidIndex(Handle.SlotIndex) && IsAcquired(Handle.SlotIndex) && Headers[Handle.SlotIndex].Generation == Handle.Generation;
+    }
+
+    ELazyPoolSlotState GetState(const int32 SlotIndex) const { return Headers[SlotIndex].State; }
+    uint32 GetGeneration(const int32 SlotIndex) const { return Headers[SlotIndex].Generation; }
+
+    /** The slot after this one in its available or in-use list. */
+    int32 GetNext(const int32 SlotIndex) const { return Headers[SlotIndex].Next; }
+
+    const FLazyPoolSlotList& GetAvailable() const { return AvailableSlots; }
+    const FLazyPoolSlotList& GetInUse() const { return InUseSlots; }
+    int32 GetNumReserved() const { return NumReserved; }
+    int32 GetNumAcquired() const { return InUseSlots.Num + NumReserved; }
+
+    /** Number of slots holding an item. */
+    int32 Num() const { return AvailableSlots.Num + InUseSlots.Num + NumReserved; }
+
+    /** One past the highest slot index, empty slots included. */
+    int32 GetMaxIndex() const { return Headers.Num(); }
+
+private:
+    struct FSlotHeader
+    {
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        uint32 Generation = 0;
+        ELazyPoolSlotState State = ELazyPoolSlotState::Empty;
+    };
+
+    // Kept apart from the items so walking the lists only touches the headers.
+    TArray<FSlotHeader> Headers;
+
+    // Only one of the two is used, depending on the policy.
+    TArray<T> Items;
+    TArray<TArray<TTypeCompatibleBytes<T>>> Blocks;
+
+    FLazyPoolSlotList AvailableSlots;
+    FLazyPoolSlotList InUseSlots;
+    int32 FirstEmptySlot = INDEX_NONE;
+    int32 NumReserved = 0;
+
+    static bool IsAcquiredState(const ELazyPoolSlotState State)
+    {
+        return State == ELazyPoolSlotState::InUse || State == ELazyPoolSlotState::Reserved;
+    }
+
+    T* GetArenaItem(const int32 SlotIndex)
+    {
+        return Blocks[SlotIndex / Policy::ArenaBlockSize][SlotIndex % Policy::ArenaBlockSize].GetTypedPtr();
+    }
+
+    void ResetLists()
+    {
+        AvailableSlots = FLazyPoolSlotList();
+        InUseSlots = FLazyPoolSlotList();
+        FirstEmptySlot = INDEX_NONE;
+        NumReserved = 0;
+    }
+
+    FLazyPoolSlotList* GetSlotList(const ELazyPoolSlotState State)
+    {
+        switch (State)
+        {
+        case ELazyPoolSlotState::Available: return &AvailableSlots;
+        case ELazyPoolSlotState::InUse: return &InUseSlots;
+        default: return nullptr;
+        }
+    }
+
+    void LinkTail(FLazyPoolSlotList& List, const int32 SlotIndex)
+    {
+        FSlotHeader& Header = Headers[SlotIndex];
+        Header.Prev = List.Tail;
+        Header.Next = INDEX_NONE;
+
+        if (List.Tail != INDEX_NONE)
+        {
+            Headers[List.Tail].Next = SlotIndex;
+        }
+        else
+        {
+            List.Head = SlotIndex;
+        }
+
+        List.Tail = SlotIndex;
+        List.Num++;
+    }
+
+    void Unlink(FLazyPoolSlotList& List, const int32 SlotIndex)
+    {
+        FSlotHeader& Header = Headers[SlotIndex];
+
+        if (Header.Prev != INDEX_NONE) Headers[Header.Prev].Next = Header.Next;
+        else List.Head = Header.Next;
+
+        if (Header.Next != INDEX_NONE) Headers[Header.Next].Prev = Header.Prev;
+        else List.Tail = Header.Prev;
+
+        Header.Prev = INDEX_NONE;
+        Header.Next = INDEX_NONE;
+        List.Num--;
+    }
+};
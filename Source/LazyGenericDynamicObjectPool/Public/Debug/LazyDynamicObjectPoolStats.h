@@ -0,0 +1,22 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Shown with "stat LazyObjectPool" in every build with stats, packaged development builds and dedicated servers included.
+DECLARE_STATS_GROUP(TEXT("LazyObjectPool"), STATGROUP_LazyObjectPool, STATCAT_Advanced);
+
+// Cycle counters, each covering every path into the operation: by class, by pool id, batched and async.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("InitializeActorFromPool"), STAT_LazyObjectPool_Initialize, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FinishInitializeActorFromPool"), STAT_LazyObjectPool_FinishInitialize, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReturnActorToPool"), STAT_LazyObjectPool_Return, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GrowActorPool"), STAT_LazyObjectPool_Grow, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ShrinkPool"), STAT_LazyObjectPool_Shrink, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+
+// Per-frame counters, reset at the start of every frame.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Acquisitions"), STAT_LazyObjectPool_Acquisitions, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Misses"), STAT_LazyObjectPool_Misses, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Growths"), STAT_LazyObjectPool_Growths, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Destroys"), STAT_LazyObjectPool_Destroys, STATGROUP_LazyObjectPool, LAZYGENERICDYNAMICOBJECTPOOL_API);
@@ -0,0 +1,57 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+// Pool operations log at Verbose and above. Shipping builds compile everything below Warning out, define this before
+// including the header to keep more.
+#ifndef LAZYOBJECTPOOL_LOG_COMPILE_VERBOSITY
+    #if UE_BUILD_SHIPPING
+        #define LAZYOBJECTPOOL_LOG_COMPILE_VERBOSITY Warning
+    #else
+        #define LAZYOBJECTPOOL_LOG_COMPILE_VERBOSITY All
+    #endif
+#endif
+
+LAZYGENERICDYNAMICOBJECTPOOL_API DECLARE_LOG_CATEGORY_EXTERN(LogLazyDynamicObjectPool, Log, LAZYOBJECTPOOL_LOG_COMPILE_VERBOSITY);
+
+#if UE_TRACE_ENABLED && !UE_BUILD_SHIPPING
+    #define LAZYOBJECTPOOL_TRACE_ENABLED 1
+#else
+    #define LAZYOBJECTPOOL_TRACE_ENABLED 0
+#endif
+
+#if LAZYOBJECTPOOL_TRACE_ENABLED
+
+// Enabled with -trace=cpu,counters,LazyObjectPool or Trace.Enable LazyObjectPool. Off, every scope and counter costs one branch.
+UE_TRACE_CHANNEL_EXTERN(LazyObjectPoolChannel, LAZYGENERICDYNAMICOBJECTPOOL_API);
+
+#define LAZYOBJECTPOOL_TRACE_IS_ENABLED() UE_TRACE_CHANNELEXPR_IS_ENABLED(LazyObjectPoolChannel)
+#define LAZYOBJECTPOOL_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("LazyObjectPool::" #Name, LazyObjectPoolChannel)
+
+#else
+
+#define LAZYOBJECTPOOL_TRACE_IS_ENABLED() false
+#define LAZYOBJECTPOOL_TRACE_SCOPE(Name)
+
+#endif
+
+#if LAZYOBJECTPOOL_TRACE_ENABLED && COUNTERSTRACE_ENABLED
+
+/** Available and in-use counters of one pool, named after its class. */
+struct FLazyObjectPoolTraceCounters
+{
+    explicit FLazyObjectPoolTraceCounters(const UClass* ObjectClass);
+
+    void Set(int32 NumAvailable, int32 NumInUse);
+
+private:
+    FCountersTrace::FCounterInt Available;
+    FCountersTrace::FCounterInt InUse;
+};
+
+#endif
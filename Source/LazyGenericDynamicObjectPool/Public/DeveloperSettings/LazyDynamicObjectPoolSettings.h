@@ -4,8 +4,109 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Types/LazyDynamicObjectPoolTypes.h"
 #include "LazyDynamicObjectPoolSettings.generated.h"
 
+class ULazyDynamicObjectPoolGrowthPolicy;
+class UObjectPoolManifest;
+class UStaticMesh;
+
+/**
+ * @struct FObjectPoolClassOverride
+ * @brief Pool configuration for one pooled class and its subclasses, each value only applies when its toggle is set.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolClassOverride
+{
+    GENERATED_BODY()
+
+    /**
+     * @brief The class the overrides apply to, subclasses without an override of their own inherit them.
+     * @note Any actor, component or object class can be targeted, the name is kept so existing config still loads.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool")
+    TSoftClassPtr<UObject> ActorClass;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideInitialPoolSize = false;
+
+    /** @brief The number of actors the pool is filled with when it is created. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideInitialPoolSize", ClampMin = "1", UIMin = "1"))
+    int32 InitialPoolSize = 10;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideMaxPoolSize = false;
+
+    /** @brief The size the pool never grows beyond, 0 for unlimited. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideMaxPoolSize", ClampMin = "0", UIMin = "0"))
+    int32 MaxPoolSize = 1000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverridePoolGrowthFactor = false;
+
+    /** @brief The growth factor applied when the pool runs dry. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverridePoolGrowthFactor", ClampMin = "1.0", UIMin = "1.0", ClampMax = "2.0", UIMax = "2.0"))
+    float PoolGrowthFactor = 1.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideShrinkThreshold = false;
+
+    /** @brief The fraction of the pool a shrink pass may remove. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideShrinkThreshold", ClampMin = "0.0", UIMin = "0.0", ClampMax = "1.0", UIMax = "1.0"))
+    float ShrinkThreshold = 0.25f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideMinResidentActors = false;
+
+    /** @brief The size shrinking never takes the pool below. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideMinResidentActors", ClampMin = "0", UIMin = "0"))
+    int32 MinResidentActors = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideParkingMode = false;
+
+    /** @brief Where the class's idle actors wait. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideParkingMode"))
+    EPooledActorParkingMode ParkingMode = EPooledActorParkingMode::Isolated;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (InlineEditConditionToggle))
+    bool bOverrideOverlapMode = false;
+
+    /** @brief When the class's acquired actors update their overlaps. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (EditCondition = "bOverrideOverlapMode"))
+    EPooledActorOverlapMode OverlapMode = EPooledActorOverlapMode::Immediate;
+};
+
+/**
+ * @struct FObjectPoolDehydrationClass
+ * @brief An actor class whose in-use actors are swapped for a mesh instance while they are far from every viewer.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolDehydrationClass
+{
+    GENERATED_BODY()
+
+    /** @brief Only actors of exactly this class are dehydrated, each pool holds a single class. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    TSoftClassPtr<AActor> ActorClass;
+
+    /** @brief Drawn through a hierarchical instanced static mesh in place of each dehydrated actor. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    TSoftObjectPtr<UStaticMesh> Mesh;
+
+    /** @brief Distance from the closest viewer beyond which an in-use actor is dehydrated and returned to the pool. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "cm"))
+    float DehydrateDistance = 8000.0f;
+
+    /**
+     * @brief Distance from the closest viewer within which a dehydrated actor is acquired from the pool again.
+     * @note Kept at or below DehydrateDistance so actors on the boundary do not swap back and forth.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "cm"))
+    float RehydrateDistance = 6000.0f;
+};
+
 /**
  * @class ULazyDynamicObjectPoolSettings
  * @brief Configuration settings for the Lazy Dynamic Object Pool system.
@@ -44,6 +145,85 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Pool Configuration", meta = (ClampMin = "1.0", UIMin = "1.0", ClampMax = "2.0", UIMax = "2.0"))
     float PoolGrowthFactor = 1.5f;
 
+    /**
+     * @brief Per-class replacements for the values above and the shrink threshold.
+     * @note A class uses the override of its closest ancestor for every value it does not override itself.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Configuration", meta = (TitleProperty = "ActorClass"))
+    TArray<FObjectPoolClassOverride> ClassOverrides;
+
+    /**
+     * @brief The policy that decides how much pools grow, how many free actors they keep ahead of demand and how far they shrink.
+     * @note The base policy reproduces the plain growth factor, the predictive policy grows ahead of the measured acquisition rate.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Growth")
+    TSoftClassPtr<ULazyDynamicObjectPoolGrowthPolicy> GrowthPolicyClass;
+
+    /**
+     * @brief The time constant in seconds of the moving average used to measure each pool's acquisition rate.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Growth", meta = (ClampMin = "0.05", UIMin = "0.05", Units = "s"))
+    float DemandSmoothingTime = 1.0f;
+
+    /**
+     * @brief Whether pool growth is spread across frames instead of spawning every actor on the calling frame.
+     * @note Acquisitions that find their pool empty still spawn one actor synchronously so they never get nullptr.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Growth")
+    bool bEnableBudgetedGrowth = true;
+
+    /**
+     * @brief The time in milliseconds the subsystem may spend spawning pooled actors each frame.
+     * @note At least one actor is spawned per frame while growth is pending, so a tiny budget still makes progress.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Growth", meta = (EditCondition = "bEnableBudgetedGrowth", ClampMin = "0.1", UIMin = "0.1", Units = "ms"))
+    float GrowthFrameBudgetMs = 1.0f;
+
+    /**
+     * @brief The number of free actors each pool tries to keep in reserve, replenished in the background.
+     * @note Set to 0 to only grow pools when they run dry.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Growth", meta = (EditCondition = "bEnableBudgetedGrowth", ClampMin = "0", UIMin = "0"))
+    int32 MinFreeActorsPerPool = 2;
+
+    /**
+     * @brief The pools prewarmed when a world begins play, used for every map without an entry in MapManifests.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Prewarm")
+    TSoftObjectPtr<UObjectPoolManifest> DefaultManifest;
+
+    /**
+     * @brief The pools prewarmed for specific maps, these replace the default manifest.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Prewarm")
+    TMap<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UObjectPoolManifest>> MapManifests;
+
+    /**
+     * @brief Whether the whole manifest is spawned while the world begins play instead of through budgeted growth.
+     * @note Blocking prewarm finishes behind the loading screen, budgeted prewarm keeps the first frames responsive.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Prewarm")
+    bool bBlockingPrewarm = true;
+
+    /**
+     * @brief Whether each session records its per-class pool usage and merges it into the map's profile under Saved/ObjectPoolProfiles.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Demand Profiles")
+    bool bRecordDemandProfiles = false;
+
+    /**
+     * @brief Whether pools are sized and prewarmed from the map's recorded profile.
+     * @note Cooked builds read the profile from Content/ObjectPoolProfiles, add that folder to the directories staged with the game.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Demand Profiles")
+    bool bUseDemandProfiles = true;
+
+    /**
+     * @brief The recorded peak usage is multiplied by this factor to get a pool's initial size.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Demand Profiles", meta = (EditCondition = "bUseDemandProfiles", ClampMin = "1.0", UIMin = "1.0", ClampMax = "2.0", UIMax = "2.0"))
+    float ProfileHeadroom = 1.25f;
+
     /**
      * @brief Whether to enable automatic pool shrinking.
      * @note If true, pools will periodically remove excess unused objects.
@@ -63,9 +243,121 @@ public:
     UPROPERTY(config, EditAnywhere, Category = "Pool Optimization", meta = (EditCondition = "bEnableAutoShrink", ClampMin = "0.0", UIMin = "0.0", ClampMax = "1.0", UIMax = "1.0"))
     float ShrinkThreshold = 0.25f;
 
+    /**
+     * @brief The time in milliseconds each frame may spend destroying actors removed by a shrink pass.
+     * @note At least one actor is destroyed per frame while a shrink is pending.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Optimization", meta = (EditCondition = "bEnableAutoShrink", ClampMin = "0.0", UIMin = "0.0", Units = "ms"))
+    float ShrinkFrameBudgetMs = 0.5f;
+
+    /**
+     * @brief How long an actor must have been sitting in the pool before a shrink pass may destroy it.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Optimization", meta = (EditCondition = "bEnableAutoShrink", ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float MinIdleTimeBeforeShrink = 10.0f;
+
+    /**
+     * @brief Free actors a pool is expected to hand out within this many seconds at its current acquisition rate are never shrunk.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Optimization", meta = (EditCondition = "bEnableAutoShrink", ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float ShrinkDemandLookahead = 5.0f;
+
+    /**
+     * @brief Where idle actors wait. With isolated parking new actors are spawned straight into it.
+     * @note Unregistered parking keeps idle actors out of the scene entirely, at the cost of registering their components on every acquire.
+     * Isolated parking turns the placement of an acquired actor into a teleport, so the sweep of FinishInitializeActorFromPool is skipped.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Parking")
+    EPooledActorParkingMode ParkingMode = EPooledActorParkingMode::None;
+
+    /**
+     * @brief Where isolated actors are parked, keep it away from the playable space and above the world's kill Z.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Parking", meta = (EditCondition = "ParkingMode == EPooledActorParkingMode::Isolated"))
+    FVector ParkingLocation = FVector(0.0, 0.0, -50000.0);
+
+    /**
+     * @brief When acquired actors update their overlaps with the world at their new location.
+     * @note Deferring or skipping the update makes bursts of acquisitions cheaper, at the cost of late or missed begin overlap events.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Pool Activation")
+    EPooledActorOverlapMode OverlapMode = EPooledActorOverlapMode::Immediate;
+
+    /**
+     * @brief Whether idle actors are demoted to the cold and hibernated tiers the longer they sit in the pool.
+     * @note Demoted actors are promoted back when they are acquired, which costs re-registering their components.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Tiers")
+    bool bEnableIdleTiers = false;
+
+    /**
+     * @brief How long an actor stays idle before its components are unregistered from the render and physics scenes.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Tiers", meta = (EditCondition = "bEnableIdleTiers", ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float ColdAfterIdleTime = 15.0f;
+
+    /**
+     * @brief How long an actor stays idle before its tick functions are unregistered and it is asked to release its heavy per-instance resources.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Tiers", meta = (EditCondition = "bEnableIdleTiers", ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float HibernateAfterIdleTime = 60.0f;
+
+    /**
+     * @brief The time in milliseconds each frame may spend demoting idle actors.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Idle Tiers", meta = (EditCondition = "bEnableIdleTiers", ClampMin = "0.0", UIMin = "0.0", Units = "ms"))
+    float IdleTierFrameBudgetMs = 0.25f;
+
+    /**
+     * @brief The memory all pooled actors together may occupy, idle actors are evicted from the costliest, least reused pools above it.
+     * @note Set to 0 to disable. The cost of a class is estimated once from the first actor spawned into its pool.
+     * Growth ahead of demand stops at the budget instead of spawning actors that would be evicted again.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Memory Budget", meta = (ClampMin = "0", UIMin = "0", Units = "Megabytes"))
+    int32 MemoryBudgetMB = 0;
+
+    /**
+     * @brief Whether the classes in DehydrationClasses are dehydrated when the world begins play.
+     * @note Classes can also be registered at runtime through the subsystem, this only controls the list below.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Dehydration")
+    bool bEnableDehydration = false;
+
+    /**
+     * @brief In-use actor classes that are dehydrated into mesh instances far from every viewer.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Dehydration", meta = (EditCondition = "bEnableDehydration", TitleProperty = "ActorClass"))
+    TArray<FObjectPoolDehydrationClass> DehydrationClasses;
+
+    /**
+     * @brief How often viewer distances are checked, in seconds.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Dehydration", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float DehydrationCheckInterval = 0.5f;
+
+    /**
+     * @brief The most actors dehydrated or rehydrated by one check, the rest wait for the next one.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Dehydration", meta = (ClampMin = "1", UIMin = "1"))
+    int32 MaxDehydrationSwapsPerCheck = 16;
+
+    /**
+     * @brief Tick group in which claims and returns queued from other threads are settled on the game thread.
+     * @note Claims settled before physics are placed in time for this frame's simulation.
+     */
+    UPROPERTY(config, EditAnywhere, Category = "Async Access")
+    TEnumAsByte<ETickingGroup> AsyncSettleTickGroup = TG_PrePhysics;
+
     /**
      * @brief Whether to log detailed information about pool operations.
+     * @note Raises LogLazyDynamicObjectPool to Verbose, the same as -LogCmds="LogLazyDynamicObjectPool Verbose". Shipping builds compile these lines out.
      */
     UPROPERTY(config, EditAnywhere, Category = "Debugging")
     bool bEnableDetailedLogging = false;
+
+    /**
+     * @brief Resolves the configuration of a class by walking up its hierarchy through ClassOverrides.
+     * @return Every value the hierarchy does not override holds the project default, the toggles tell which ones were overridden.
+     */
+    FObjectPoolClassOverride ResolveClassOverride(const UClass* ActorClass) const;
 };
\ No newline at end of file
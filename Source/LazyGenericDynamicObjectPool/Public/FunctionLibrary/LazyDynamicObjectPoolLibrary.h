@@ -5,10 +5,9 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+#include "Debug/LazyDynamicObjectPoolTrace.h"
 #include "LazyDynamicObjectPoolLibrary.generated.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogLazyDynamicObjectPool, Log, All);
-
 /**
  * 
  */
@@ -20,4 +19,12 @@ class LAZYGENERICDYNAMICOBJECTPOOL_API ULazyDynamicObjectPoolLibrary : public UB
 public:
 	UFUNCTION(BlueprintPure, Category = "LazyDynamicObjectPoolLibrary", meta = (WorldContext = "ContextObject", BlueprintInternalUseOnly = "true"))
 	static ULazyDynamicObjectPoolSubsystem* GetSubsystem(const UObject* ContextObject);
+
+	/**
+	 * Returns Subsystem, resolving it and the pool of ActorClass into the caches only while Subsystem is not valid.
+	 * The spawn nodes keep the caches in temporaries so a node resolves both once instead of on every spawn.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LazyDynamicObjectPoolLibrary", meta = (WorldContext = "ContextObject", BlueprintInternalUseOnly = "true"))
+	static ULazyDynamicObjectPoolSubsystem* ResolvePoolCached(const UObject* ContextObject, TSubclassOf<AActor> ActorClass,
+		UPARAM(ref) ULazyDynamicObjectPoolSubsystem*& Subsystem, UPARAM(ref) FObjectPoolId& PoolId);
 };
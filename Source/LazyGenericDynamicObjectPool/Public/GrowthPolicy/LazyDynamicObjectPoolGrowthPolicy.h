@@ -0,0 +1,123 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "LazyDynamicObjectPoolGrowthPolicy.generated.h"
+
+/**
+ * @struct FObjectPoolDemandStats
+ * @brief Snapshot of one pool's usage handed to the growth policy.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolDemandStats
+{
+    GENERATED_BODY()
+
+    /** @brief Actors sitting in the pool, ready to be acquired. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    int32 NumAvailable = 0;
+
+    /** @brief Actors currently acquired, including those between initialize and finish. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    int32 NumInUse = 0;
+
+    /** @brief Actors queued for budgeted spawning. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    int32 NumPending = 0;
+
+    /** @brief Smoothed acquisitions per second over the recent frames. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    float AcquisitionRate = 0.0f;
+
+    /** @brief Highest concurrent usage since the last shrink pass. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    int32 PeakInUse = 0;
+
+    /** @brief Seconds since the pool last grew. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    float TimeSinceLastGrowth = 0.0f;
+
+    /** @brief The size an empty pool is filled up to. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    int32 InitialSize = 0;
+
+    /** @brief The class's growth factor from the project settings. */
+    UPROPERTY(BlueprintReadOnly, Category = "Object Pool")
+    float GrowthFactor = 1.5f;
+
+    /** @brief The pool's total size, available plus in use. */
+    int32 GetPoolSize() const { return NumAvailable + NumInUse; }
+};
+
+/**
+ * @class ULazyDynamicObjectPoolGrowthPolicy
+ * @brief Decides how much a pool grows and how far it may shrink.
+ *
+ * The base policy reproduces the fixed growth factor: it only grows once a pool has run dry and never
+ * grows ahead of demand. Subclass it, in C++ or Blueprint, and select it in the project settings to change how pools are sized.
+ */
+UCLASS(Blueprintable)
+class LAZYGENERICDYNAMICOBJECTPOOL_API ULazyDynamicObjectPoolGrowthPolicy : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * @brief How many actors to add to a pool that could not serve an acquisition.
+     * @param Stats The pool's current usage.
+     * @param MinimumGrowth The number of actors the caller needs right now.
+     */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool|Growth Policy")
+    int32 GetGrowthAmount(const FObjectPoolDemandStats& Stats, int32 MinimumGrowth) const;
+
+    /**
+     * @brief How many free actors the pool should hold ahead of demand, topped up in the background.
+     */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool|Growth Policy")
+    int32 GetDesiredFreeActors(const FObjectPoolDemandStats& Stats) const;
+
+    /**
+     * @brief The size a shrink pass may bring the pool down to.
+     * @param DefaultTarget The target computed from the shrink threshold settings.
+     */
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool|Growth Policy")
+    int32 GetShrinkTarget(const FObjectPoolDemandStats& Stats, int32 DefaultTarget) const;
+
+protected:
+    virtual int32 GetGrowthAmount_Implementation(const FObjectPoolDemandStats& Stats, int32 MinimumGrowth) const;
+    virtual int32 GetDesiredFreeActors_Implementation(const FObjectPoolDemandStats& Stats) const;
+    virtual int32 GetShrinkTarget_Implementation(const FObjectPoolDemandStats& Stats, int32 DefaultTarget) const;
+};
+
+/**
+ * @class ULazyDynamicObjectPoolPredictiveGrowthPolicy
+ * @brief Grows pools ahead of demand from their smoothed acquisition rate and recent peak usage.
+ *
+ * Free actors are kept in proportion to how fast a pool is being drained, and shrinking never cuts
+ * below the recent peak or follows a growth too closely so the two do not undo each other.
+ */
+UCLASS()
+class LAZYGENERICDYNAMICOBJECTPOOL_API ULazyDynamicObjectPoolPredictiveGrowthPolicy : public ULazyDynamicObjectPoolGrowthPolicy
+{
+    GENERATED_BODY()
+
+public:
+    /** @brief Seconds of demand at the current acquisition rate that are kept free ahead of time. */
+    UPROPERTY(EditAnywhere, Category = "Growth Policy", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float LeadTime = 0.5f;
+
+    /** @brief Fraction of the recent peak usage a shrink pass keeps resident. */
+    UPROPERTY(EditAnywhere, Category = "Growth Policy", meta = (ClampMin = "0.0", UIMin = "0.0", ClampMax = "2.0", UIMax = "2.0"))
+    float PeakRetention = 1.1f;
+
+    /** @brief Seconds after a growth during which the pool is not shrunk. */
+    UPROPERTY(EditAnywhere, Category = "Growth Policy", meta = (ClampMin = "0.0", UIMin = "0.0", Units = "s"))
+    float ShrinkCooldown = 10.0f;
+
+protected:
+    virtual int32 GetGrowthAmount_Implementation(const FObjectPoolDemandStats& Stats, int32 MinimumGrowth) const override;
+    virtual int32 GetDesiredFreeActors_Implementation(const FObjectPoolDemandStats& Stats) const override;
+    virtual int32 GetShrinkTarget_Implementation(const FObjectPoolDemandStats& Stats, int32 DefaultTarget) const override;
+};
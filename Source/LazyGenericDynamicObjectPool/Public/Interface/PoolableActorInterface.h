@@ -36,6 +36,34 @@ public:
 	 */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool")
 	void OnDeactivateToPool();
+
+	/**
+	 * Called when the actor has been idle long enough to hibernate, its components and tick functions are already unregistered.
+	 * Use this to release heavy per-instance resources such as dynamic materials or cached animation data.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool")
+	void OnHibernateInPool();
+
+	/**
+	 * Called when a hibernated actor is acquired again, after its components are registered and before it is activated.
+	 * Use this to restore what OnHibernateInPool released.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool")
+	void OnWakeFromPool();
+
+	/**
+	 * Called when the in-use actor is about to be dehydrated into a mesh instance, before it is returned to the pool.
+	 * Return whatever state the actor needs to carry on when it is rehydrated, keep it small.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool")
+	TArray<uint8> OnDehydrateInPool();
+
+	/**
+	 * Called when a dehydrated actor is acquired again because a viewer came close, after it has been activated.
+	 * Receives the state returned from OnDehydrateInPool, which may have been captured on a different actor.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Object Pool")
+	void OnRehydrateFromPool(const TArray<uint8>& State);
 	
 	void ResetActor();
 };
@@ -0,0 +1,53 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ObjectPoolManifest.generated.h"
+
+/**
+ * @struct FObjectPoolManifestEntry
+ * @brief One pool to create and fill when a world begins play.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolManifestEntry
+{
+    GENERATED_BODY()
+
+    /** @brief The class of actor to pool. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool")
+    TSoftClassPtr<AActor> ActorClass;
+
+    /** @brief The number of actors spawned into the pool before gameplay needs them. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (ClampMin = "1", UIMin = "1"))
+    int32 InitialSize = 10;
+
+    /**
+     * @brief The maximum number of actors the pool may hold.
+     * @note Set to 0 to use the maximum pool size from the project settings.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (ClampMin = "0", UIMin = "0"))
+    int32 MaxSize = 0;
+
+    /** @brief Pools with a higher priority are filled first. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool")
+    int32 Priority = 0;
+};
+
+/**
+ * @class UObjectPoolManifest
+ * @brief Lists the pools to prewarm when a world begins play, so the first use of a pooled actor does not pay its spawn cost.
+ *
+ * Reference one from the project settings, either as the default manifest or for a specific map.
+ */
+UCLASS(BlueprintType)
+class LAZYGENERICDYNAMICOBJECTPOOL_API UObjectPoolManifest : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** @brief The pools to prewarm. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Object Pool", meta = (TitleProperty = "ActorClass"))
+    TArray<FObjectPoolManifestEntry> Entries;
+};
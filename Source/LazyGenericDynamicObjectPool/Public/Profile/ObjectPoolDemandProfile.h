@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ObjectPoolDemandProfile.generated.h"
+
+/**
+ * @struct FObjectPoolClassProfile
+ * @brief Recorded usage of one pooled class.
+ */
+USTRUCT()
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolClassProfile
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FSoftClassPath ActorClass;
+
+    /** @brief Highest concurrent usage seen in any recorded session. */
+    UPROPERTY()
+    int32 PeakInUse = 0;
+
+    /** @brief Times the pool had to grow, summed over the recorded sessions. */
+    UPROPERTY()
+    int32 GrowthEvents = 0;
+
+    /** @brief Acquisitions that found the pool empty, summed over the recorded sessions. */
+    UPROPERTY()
+    int32 Misses = 0;
+
+    UPROPERTY()
+    int32 NumSessions = 0;
+};
+
+/**
+ * @struct FObjectPoolDemandProfile
+ * @brief Pool usage recorded for one map, stored as json so it can be merged across sessions and shipped with cooked builds.
+ */
+USTRUCT()
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolDemandProfile
+{
+    GENERATED_BODY()
+
+    /** @brief Bumped whenever the layout changes, profiles with another version are ignored. */
+    static constexpr int32 CurrentVersion = 1;
+
+    UPROPERTY()
+    int32 Version = CurrentVersion;
+
+    UPROPERTY()
+    TArray<FObjectPoolClassProfile> Classes;
+
+    /** @brief Folds another profile into this one, keeping the highest peak and summing the counters. */
+    void Merge(const FObjectPoolDemandProfile& Other);
+
+    const FObjectPoolClassProfile* FindClass(const FSoftClassPath& ActorClass) const;
+
+    bool LoadFromFile(const FString& FilePath);
+    bool SaveToFile(const FString& FilePath) const;
+
+    /** @brief Where sessions record the profile of a map. */
+    static FString GetSavedFilePath(const FString& MapName);
+
+    /** @brief Where a profile shipped with the project is looked up when nothing was recorded locally. */
+    static FString GetShippedFilePath(const FString& MapName);
+};
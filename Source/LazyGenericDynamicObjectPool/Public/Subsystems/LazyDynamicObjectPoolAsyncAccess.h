@@ -0,0 +1,104 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Types/LazyDynamicObjectPoolTypes.h"
+#include <atomic>
+#include "LazyDynamicObjectPoolAsyncAccess.generated.h"
+
+class ULazyDynamicObjectPoolSubsystem;
+
+/** Requests queued by any thread, drained by the subsystem on the game thread once per frame. */
+struct FLazyObjectPoolAsyncQueues
+{
+    struct FAcquireRequest
+    {
+        int32 PoolIndex = INDEX_NONE;
+        FTransform Transform;
+        TFunction<void(AActor*)> OnAcquired;
+    };
+
+    TQueue<FAcquireRequest, EQueueMode::Mpsc> Acquires;
+    TQueue<TWeakObjectPtr<AActor>, EQueueMode::Mpsc> Returns;
+    TQueue<FPooledActorHandle, EQueueMode::Mpsc> HandleReturns;
+};
+
+/** Reservation counters of one pool, claimed by any thread and settled by the game thread. */
+struct FLazyObjectPoolAsyncCounters
+{
+    // Claims the game thread has not turned into actors yet.
+    std::atomic<int32> NumClaimed { 0 };
+
+    // Acquisitions the pool can still take before it reaches its size limit, published by the game thread every frame.
+    std::atomic<int32> Headroom { MAX_int32 };
+};
+
+/**
+ * @class FObjectPoolAsyncAccess
+ * @brief Lock-free front end to one pool for worker threads, physics callbacks and tasks.
+ *
+ * Resolved on the game thread through ULazyDynamicObjectPoolSubsystem::GetAsyncAccess, then safe to copy to and use from
+ * any thread. Claims and returns only touch atomics and multi-producer queues. The subsystem turns them into actual
+ * acquisitions and returns on the game thread in its async tick, whose tick group is set in the project settings.
+ * Outlives the subsystem safely, anything queued after the world is torn down is dropped.
+ */
+class LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolAsyncAccess
+{
+public:
+    FObjectPoolAsyncAccess() = default;
+    FObjectPoolAsyncAccess(const int32 InPoolIndex, const TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe>& InCounters,
+        const TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe>& InQueues)
+        : PoolIndex(InPoolIndex), Counters(InCounters), Queues(InQueues)
+    {
+    }
+
+    bool IsValid() const { return PoolIndex != INDEX_NONE && Counters.IsValid() && Queues.IsValid(); }
+
+    /**
+     * Claims an actor from the pool. OnAcquired runs on the game thread during the next async tick with the acquired
+     * actor, placed at Transform, or with null if the pool failed to create one.
+     * @return False, without queuing anything, when the pool has no room left for the claim.
+     */
+    bool TryClaimActor(const FTransform& Transform, TFunction<void(AActor*)>&& OnAcquired) const;
+
+    /** Queues an actor to be returned to its pool on the game thread. Actors destroyed in the meantime are skipped. */
+    void EnqueueReturn(AActor* Actor) const;
+
+    /** Queues the actor behind a handle to be returned, ignored if the handle went stale before the game thread got to it. */
+    void EnqueueReturn(const FPooledActorHandle& Handle) const;
+
+    /** Claims not yet settled on the game thread. */
+    int32 GetNumPendingClaims() const { return Counters.IsValid() ? Counters->NumClaimed.load(std::memory_order_relaxed) : 0; }
+
+private:
+    int32 PoolIndex = INDEX_NONE;
+    TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe> Counters;
+    TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe> Queues;
+};
+
+/**
+ * @struct FLazyObjectPoolAsyncTickFunction
+ * @brief Settles the claims and returns queued through FObjectPoolAsyncAccess, once per frame in the configured tick group.
+ */
+USTRUCT()
+struct FLazyObjectPoolAsyncTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    ULazyDynamicObjectPoolSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLazyObjectPoolAsyncTickFunction> : public TStructOpsTypeTraitsBase2<FLazyObjectPoolAsyncTickFunction>
+{
+    enum
+    {
+        WithCopy = false
+    };
+};
@@ -4,14 +4,41 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "Types/LazyDynamicObjectPoolTypes.h"
+#include "Containers/LazyObjectPool.h"
+#include "Subsystems/LazyDynamicObjectPoolAsyncAccess.h"
+#include "Profile/ObjectPoolDemandProfile.h"
+#include "Debug/LazyDynamicObjectPoolTrace.h"
 #include "LazyDynamicObjectPoolSubsystem.generated.h"
 
 class ULazyDynamicObjectPoolSettings;
+class ULazyDynamicObjectPoolGrowthPolicy;
+class UObjectPoolManifest;
+class UInstancedStaticMeshComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+struct FObjectPoolDehydrationClass;
+struct FObjectPoolDemandStats;
 
 DECLARE_MULTICAST_DELEGATE(FDynamicObjectPoolAction);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPoolPrewarmProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnProjectileMaterialized, AActor*, Actor, const FHitResult&, Hit);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPooledActorDehydrated, AActor*, Actor);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnPooledActorRehydrated, AActor*, OriginalActor, AActor*, StandInActor);
+
+/**
+ * @struct FPooledActorFuture
+ * @brief A pending acquisition from AcquireActorFromPoolFuture, cancel it through its request id.
+ */
+struct FPooledActorFuture
+{
+    /** INDEX_NONE if the request could not be queued, the future is then already set to null. */
+    int32 RequestId = INDEX_NONE;
+    TFuture<AActor*> Future;
+};
 
 UCLASS()
-class LAZYGENERICDYNAMICOBJECTPOOL_API ULazyDynamicObjectPoolSubsystem : public UWorldSubsystem
+class LAZYGENERICDYNAMICOBJECTPOOL_API ULazyDynamicObjectPoolSubsystem : public UTickableWorldSubsystem
 {
     GENERATED_BODY()
 
@@ -22,22 +49,260 @@ public:
     FDynamicObjectPoolAction OnActorSpawn;
     FDynamicObjectPoolAction OnActorDestroy;
 
+    /** Broadcast as manifest pools fill up, with the fraction of prewarmed actors spawned so far. Reaches 1 once prewarm is complete. */
+    UPROPERTY(BlueprintAssignable, Category = "Object Pool")
+    FOnPoolPrewarmProgress OnPrewarmProgress;
+
+    /** Broadcast when a projectile record turns into an actor, with the hit that caused it. The hit is empty when gameplay asked for the actor. */
+    UPROPERTY(BlueprintAssignable, Category = "Object Pool|Projectiles")
+    FOnProjectileMaterialized OnProjectileMaterialized;
+
+    /** Broadcast for an in-use actor about to be dehydrated, right before it is returned to the pool. */
+    UPROPERTY(BlueprintAssignable, Category = "Object Pool|Dehydration")
+    FOnPooledActorDehydrated OnActorDehydrated;
+
+    /**
+     * Broadcast with the actor acquired to stand in for a dehydrated one, once its state has been restored. OriginalActor is
+     * the actor OnActorDehydrated was broadcast for, null if it has been destroyed since. It may be the stand-in itself or
+     * stand in for another dehydrated actor by now, the pool hands its actors out again.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Object Pool|Dehydration")
+    FOnPooledActorRehydrated OnActorRehydrated;
+
 
 private:
- 
+
+    // What a pool holds, decided by its class. Everything but creation, activation and destruction is shared.
+    enum class EObjectPoolKind : uint8
+    {
+        Actor,
+        Component,
+        Object
+    };
+
+    // What one slot of the slot table holds, the slot lifecycle itself is handled by TLazyObjectPool.
+    struct FPoolSlot
+    {
+        UObject* Object = nullptr;
+
+        // World time the actor was spawned or last returned, an available actor has been idle since then.
+        double LastReturnedTime = 0.0;
+
+        // Components that were active when the actor spawned, the only ones activation touches. Held weakly since
+        // gameplay may destroy them, the pool does not keep them alive.
+        TArray<TWeakObjectPtr<UActorComponent>> Components;
+        EPooledActorIdleTier IdleTier = EPooledActorIdleTier::Warm;
+
+        // Set while the object's return deactivates it, a return made from one of its own callbacks is ignored.
+        bool bReturning = false;
+
+        // Only valid in actor pools, which never hold anything else.
+        AActor* GetActor() const { return static_cast<AActor*>(Object); }
+    };
+
+    // Last available slot an idle tier walk has finished with, only trusted while the slot has not left the available list since.
+    struct FIdleTierCursor
+    {
+        int32 SlotIndex = INDEX_NONE;
+        uint32 Generation = 0;
+    };
+
+    // Built once per class from its default object so acquire and return do not have to rediscover it.
+    struct FActivationPlan
+    {
+        bool bBuilt = false;
+        bool bImplementsInterface = false;
+        bool bToggleCollision = true;
+        bool bToggleTick = true;
+        bool bToggleVisibility = false;
+        EPooledActorParkingMode ParkingMode = EPooledActorParkingMode::None;
+        EPooledActorOverlapMode OverlapMode = EPooledActorOverlapMode::Immediate;
+    };
+
     struct FObjectPool
     {
-        TArray<AActor*> AvailableObjects;
-        TArray<AActor*> InUseObjects;
+        UClass* ObjectClass = nullptr;
+        EObjectPoolKind Kind = EObjectPoolKind::Actor;
+
+        // Available slots are ordered by return time, the head is the object that has been idle the longest.
+        TLazyObjectPool<FPoolSlot> Slots;
+
+        // Actors queued for budgeted spawning, not yet part of the pool.
+        int32 PendingGrowth = 0;
+
+        // Idle actors queued for budgeted destruction by the last shrink pass.
+        int32 PendingShrink = 0;
+
+        // Resolved from the class overrides in the project settings when the pool is created, a prewarm
+        // manifest can change them later. An initial size of 0 falls back to the default, a max size of 0 is unlimited.
+        int32 InitialSize = 0;
+        int32 MaxSize = 0;
+        float GrowthFactor = 1.5f;
+        float ShrinkThreshold = 0.25f;
+        int32 MinResidentActors = 0;
+        EPooledActorParkingMode ParkingMode = EPooledActorParkingMode::None;
+        EPooledActorOverlapMode OverlapMode = EPooledActorOverlapMode::Immediate;
+        int32 Priority = 0;
+
+        struct FPoolDemand
+        {
+            int32 AcquisitionsThisFrame = 0;
+            float AcquisitionRate = 0.0f;
+            int32 PeakInUse = 0;
+            double LastGrowthTime = 0.0;
+            int32 NumMisses = 0;
+
+            // Free actors and misses the fixed growth factor would have had, to measure what the policy saves.
+            int32 LegacyFreeActors = 0;
+            int32 NumLegacyMisses = 0;
+        } Demand;
+
+        // Recorded into the demand profile, kept across ClearAllPools so the whole session is covered.
+        struct FPoolSession
+        {
+            int32 PeakInUse = 0;
+            int32 GrowthEvents = 0;
+            int32 Misses = 0;
+        } Session;
+
+        FActivationPlan ActivationPlan;
+
+        // Estimated memory owned by one instance of the class, measured on the first one created for the pool.
+        int64 ActorResidentBytes = 0;
+
         int32 AccessCount = 0;
         int32 TotalGrowthOperations = 0;
+
+        // Where the cold and hibernate walks pick up, so demoted actors at the head are not visited again every frame.
+        FIdleTierCursor ColdCursor;
+        FIdleTierCursor HibernateCursor;
+
+        // Created the first time the pool is handed out for async access, shared with every FObjectPoolAsyncAccess of it.
+        TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe> AsyncCounters;
+
+#if LAZYOBJECTPOOL_TRACE_ENABLED && COUNTERSTRACE_ENABLED
+        // Created the first frame the trace channel is on, so untraced sessions never register the counters.
+        TUniquePtr<FLazyObjectPoolTraceCounters> TraceCounters;
+#endif
+
+        int32 Num() const { return Slots.Num(); }
     };
 
-    TMap<TSubclassOf<AActor>, FObjectPool> ObjectPools;
+    // Back-pointer from a pooled object to the slot that owns it.
+    struct FPoolSlotRef
+    {
+        int32 PoolIndex = INDEX_NONE;
+        int32 SlotIndex = INDEX_NONE;
+    };
+
+    // Pools are never removed once created so their index stays valid for the lifetime of the subsystem.
+    TArray<FObjectPool> ObjectPools;
+    TMap<const UClass*, int32> PoolIndexByClass;
+    TMap<const UObject*, FPoolSlotRef> PooledObjectSlots;
+
+    struct FPrewarmTarget
+    {
+        int32 PoolIndex = INDEX_NONE;
+        int32 Size = 0;
+    };
+
+    // Manifest pools that have not reached their initial size yet.
+    TArray<FPrewarmTarget> PrewarmTargets;
+    float PrewarmProgress = 1.0f;
+
+    // Projectiles of a registered class flying as plain records instead of actors. Stored as structure of arrays so the
+    // step streams through positions, velocities and lifetimes only, record i is drawn by instance i of the renderer.
+    struct FProjectileRecords
+    {
+        TSubclassOf<AActor> ActorClass;
+        FPooledProjectileConfig Config;
+        UInstancedStaticMeshComponent* Renderer = nullptr;
+
+        TArray<FVector> Positions;
+        TArray<FVector> Velocities;
+        TArray<float> RemainingLifetimes;
+
+        // Records are removed by swapping the last one into their place, handles go through these stable ids.
+        TArray<int32> IdByRecord;
+        TArray<int32> RecordById;
+        TArray<uint32> GenerationById;
+        TArray<int32> FreeIds;
+
+        int32 Num() const { return Positions.Num(); }
+    };
+
+    // Only ever appended to, handles keep the index of the class they were launched for.
+    TArray<FProjectileRecords> ProjectileRecords;
+    TMap<const UClass*, int32> ProjectileRecordsByClass;
+
+    struct FMaterializedProjectile
+    {
+        int32 ClassIndex = INDEX_NONE;
+        float RemainingLifetime = 0.0f;
+        double MaterializedTime = 0.0;
+    };
+
+    // Actors that came out of a record, kept until they are returned so their flight can be handed back.
+    TMap<const AActor*, FMaterializedProjectile> MaterializedProjectiles;
+
+    // In-use actors of a configured class that are far from every viewer. Each is held as an instance of the class's mesh
+    // and the state the actor handed over, while the actor itself went back to the pool. Entry i is drawn by instance i.
+    struct FDehydratedActors
+    {
+        TSubclassOf<AActor> ActorClass;
+        UHierarchicalInstancedStaticMeshComponent* Renderer = nullptr;
+        double DehydrateDistanceSquared = 0.0;
+        double RehydrateDistanceSquared = 0.0;
+
+        TArray<FTransform> Transforms;
+        TArray<TArray<uint8>> States;
+        TArray<TWeakObjectPtr<AActor>> OriginalActors;
+    };
+
+    TArray<FDehydratedActors> DehydratedActors;
+    TMap<const UClass*, int32> DehydratedActorsByClass;
+    double NextDehydrationCheckTime = 0.0;
+
+    // Claims and returns queued from other threads, settled by AsyncTickFunction on the game thread.
+    TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe> AsyncQueues;
+    FLazyObjectPoolAsyncTickFunction AsyncTickFunction;
+
+    // Acquisitions waiting for their pool to have an actor free, completed from the tick.
+    struct FPendingAsyncAcquire
+    {
+        int32 RequestId = INDEX_NONE;
+        int32 PoolIndex = INDEX_NONE;
+        int32 Priority = 0;
+
+        // World time after which the request completes with null, 0 waits forever.
+        double Deadline = 0.0;
+
+        // Whether to place and activate the actor, or only reserve it for the caller to finish.
+        bool bActivate = true;
+        FTransform Transform;
+        TWeakObjectPtr<AActor> Owner;
+        TFunction<void(AActor*)> OnCompleted;
+
+        // Completes the request with null once it is destroyed, an abandoned request never takes an actor.
+        TWeakObjectPtr<const UObject> Requester;
+    };
+
+    // Sorted by descending priority, first come first served within one priority.
+    TArray<FPendingAsyncAcquire> PendingAsyncAcquires;
+    int32 NextAsyncAcquireId = 0;
+
+    // Acquisitions whose overlap update was deferred to the next tick, skipped if the actor was returned in the meantime.
+    TArray<FPooledActorHandle> PendingOverlapUpdates;
+
+    FObjectPoolDemandProfile DemandProfile;
+    FString ProfileMapName;
 
     UPROPERTY()
     ULazyDynamicObjectPoolSettings* Settings = nullptr;
 
+    UPROPERTY()
+    ULazyDynamicObjectPoolGrowthPolicy* GrowthPolicy = nullptr;
+
     FTimerHandle AutoShrinkTimerHandle;
     FTimerHandle ShrinkTimeProgressTimerHandle;
     float NextShrinkTime = 0;
@@ -45,9 +310,14 @@ private:
 
 public:
     ULazyDynamicObjectPoolSubsystem();
- 
+
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
     UFUNCTION(BlueprintCallable, Category = "Object Pool")
     bool CreatePool(TSubclassOf<AActor> ClassType, int32 InitialSize = -1);
@@ -55,15 +325,228 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true"))
     AActor* InitializeActorFromPool(TSubclassOf<AActor> ActorClass, AActor* NewOwner);
 
-    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true"))
+    /**
+     * Places the actor and re-enables its collision in a single scene update, then activates it.
+     * A sweep starts from where the actor was returned, actors parked in isolation are always teleported instead.
+     * @return Null for a pooled actor that is not reserved, finish only actors from InitializeActorFromPool.
+     */
     AActor* FinishInitializeActorFromPool(AActor* Actor, const FTransform& NewTransform, bool bSweep = false,
-    FHitResult OutSweepHitResult = FHitResult(), ETeleportType Teleport = ETeleportType::None);
+    FHitResult* OutSweepHitResult = nullptr, ETeleportType Teleport = ETeleportType::None);
+
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Finish Initialize Actor From Pool"))
+    AActor* K2_FinishInitializeActorFromPool(AActor* Actor, const FTransform& NewTransform, bool bSweep, FHitResult& SweepHitResult, bool bTeleport);
 
     UFUNCTION(BlueprintCallable, Category = "Object Pool")
     void ReturnActorToPool(AActor* Actor);
- 
+
+    /**
+     * Reserves and activates Count actors in one pass, growing the pool at most once.
+     * Transforms may be empty (identity), hold a single shared transform, or hold one transform per actor.
+     * @return The number of actors appended to OutActors, less than Count if the pool hit its size limit.
+     */
+    int32 AcquireActorsFromPool(TSubclassOf<AActor> ActorClass, int32 Count, TArrayView<const FTransform> Transforms,
+    TArray<AActor*>& OutActors, AActor* NewOwner = nullptr);
+
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true"))
+    TArray<AActor*> InitializeActorsFromPool(TSubclassOf<AActor> ActorClass, int32 Count, AActor* NewOwner);
+
+    /**
+     * Activates actors reserved by InitializeActorsFromPool, skipping any that are not reserved.
+     * NewTransforms may be empty (identity), hold a single shared transform, or hold one transform per actor. Any other count
+     * returns the reservations to their pool.
+     * @return The actors that were activated.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true"))
+    TArray<AActor*> FinishInitializeActorsFromPool(const TArray<AActor*>& Actors, const TArray<FTransform>& NewTransforms);
+
+    /**
+     * Returns many actors at once. Actors are grouped by pool, deactivated in one pass and each pool's
+     * bookkeeping and logging is done once, OnActorAddedToPool fires a single time for the whole batch.
+     */
+    void ReturnActorsToPool(TArrayView<AActor* const> Actors);
+
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (DisplayName = "Return Actors To Pool"))
+    void K2_ReturnActorsToPool(const TArray<AActor*>& Actors) { ReturnActorsToPool(Actors); }
+
+    /** Acquires and activates an actor in one call, the returned handle identifies this acquisition only. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (AdvancedDisplay = "NewOwner"))
+    FPooledActorHandle AcquireActorFromPool(TSubclassOf<AActor> ActorClass, const FTransform& NewTransform, AActor* NewOwner = nullptr);
+
+    /** Returns the actor behind the handle to its pool. Stale handles are ignored and return false. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    bool ReturnActorHandleToPool(const FPooledActorHandle& Handle);
+
+    /** Handle for the current acquisition of an actor, unset if the actor is not pooled or sits in the pool. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    FPooledActorHandle GetPooledActorHandle(const AActor* Actor) const;
+
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    bool IsPooledActorHandleValid(const FPooledActorHandle& Handle) const;
+
+    /** Resolves a handle to its actor, null if the handle is stale. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    AActor* GetActorFromHandle(const FPooledActorHandle& Handle) const;
+
+    /** Resolves the dense id of the pool for a class, registering an empty pool if there isn't one yet. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    FObjectPoolId ResolvePoolId(TSubclassOf<AActor> ActorClass);
+
+    /** Same as InitializeActorFromPool but addresses the pool by id, skipping the class lookup. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (BlueprintInternalUseOnly = "true"))
+    AActor* InitializeActorFromPoolId(FObjectPoolId PoolId, AActor* NewOwner);
+
+    /** Reserves and activates an actor from a resolved pool without any map lookup on the way. */
+    AActor* AcquireActorFromPoolId(FObjectPoolId PoolId, const FTransform& NewTransform, AActor* NewOwner = nullptr);
+
+    /**
+     * Acquires an actor once the pool can hand one out, instead of returning null while it is at its maximum size or
+     * waiting on budgeted growth. OnCompleted runs on the game thread from the subsystem's tick with the placed and activated actor,
+     * or with null if Timeout seconds of world time pass first (0 waits forever). Requests for the same pool with a higher
+     * priority are served first. A request made with a Requester completes with null as soon as the requester is destroyed.
+     * @return Id to cancel the request with, INDEX_NONE if the class is not valid.
+     */
+    int32 AcquireActorFromPoolAsync(TSubclassOf<AActor> ActorClass, const FTransform& NewTransform, TFunction<void(AActor*)>&& OnCompleted,
+        float Timeout = 0.0f, int32 Priority = 0, AActor* NewOwner = nullptr, const UObject* Requester = nullptr);
+
+    /**
+     * Same as AcquireActorFromPoolAsync, but completes with a reserved actor for the caller to set up and pass to
+     * FinishInitializeActorFromPool, or to hand back with ReleaseReservedActor.
+     */
+    int32 InitializeActorFromPoolAsync(TSubclassOf<AActor> ActorClass, AActor* NewOwner, TFunction<void(AActor*)>&& OnCompleted,
+        float Timeout = 0.0f, int32 Priority = 0, const UObject* Requester = nullptr);
+
+    /**
+     * Puts an actor reserved by InitializeActorFromPool back without finishing it. It was never activated, so nothing is
+     * deactivated and no return callback runs.
+     * @return False if the actor is not pooled or not reserved, finished actors go back through ReturnActorToPool.
+     */
+    bool ReleaseReservedActor(AActor* Actor);
+
+    /** AcquireActorFromPoolAsync as a future, fulfilled on the game thread. Set to null on timeout, cancellation or teardown. */
+    FPooledActorFuture AcquireActorFromPoolFuture(TSubclassOf<AActor> ActorClass, const FTransform& NewTransform,
+        float Timeout = 0.0f, int32 Priority = 0, AActor* NewOwner = nullptr);
+
+    /** Drops a pending async acquisition, completing it with null right away. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    bool CancelAsyncAcquire(int32 RequestId);
+
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetNumPendingAsyncAcquires() const { return PendingAsyncAcquires.Num(); }
+
+    /**
+     * Lock-free access to a resolved pool for worker threads. Claims and returns made through it are settled on the game
+     * thread once per frame, in the tick group set by AsyncSettleTickGroup in the project settings.
+     */
+    FObjectPoolAsyncAccess GetAsyncAccess(FObjectPoolId PoolId);
+
+    /** Resolves a typed pool reference once, keep it around and pass it to AcquireTyped on the hot path. */
+    template<typename T>
+    TPoolRef<T> ResolvePool(TSubclassOf<T> ActorClass = T::StaticClass())
+    {
+        static_assert(TIsDerivedFrom<T, AActor>::Value, "Pooled classes must derive from AActor");
+        return TPoolRef<T>(ResolvePoolId(ActorClass));
+    }
+
+    template<typename T>
+    T* AcquireTyped(const TPoolRef<T>& Pool, const FTransform& NewTransform, AActor* NewOwner = nullptr)
+    {
+        // The pool only ever holds instances of the class it was resolved for, so the cast is statically safe.
+        return static_cast<T*>(AcquireActorFromPoolId(Pool.GetPoolId(), NewTransform, NewOwner));
+    }
+
+    template<typename T>
+    T* AcquireTyped(const FTransform& NewTransform, AActor* NewOwner = nullptr)
+    {
+        return AcquireTyped<T>(ResolvePool<T>(), NewTransform, NewOwner);
+    }
+
+    /**
+     * Acquires a pooled component, attached to AttachTo at Transform relative to the socket if given, placed at Transform in world space otherwise.
+     * Pooled components belong to the world rather than an actor and stay registered while idle, so reusing one costs no NewObject or RegisterComponent.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (DeterminesOutputType = "ComponentClass", AdvancedDisplay = "SocketName"))
+    UActorComponent* AcquireComponentFromPool(TSubclassOf<UActorComponent> ComponentClass, USceneComponent* AttachTo, const FTransform& Transform, FName SocketName = NAME_None);
+
+    /** Deactivates, hides and detaches the component and returns it to its pool. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    void ReturnComponentToPool(UActorComponent* Component);
+
+    /** Acquires a plain object from its pool, actor and component classes have their own acquire functions. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool", meta = (DeterminesOutputType = "ObjectClass"))
+    UObject* AcquireObjectFromPool(TSubclassOf<UObject> ObjectClass);
+
+    /** Returns any pooled object to its pool, including actors and components. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    void ReturnObjectToPool(UObject* Object);
+
+    template<typename T>
+    T* AcquireComponent(USceneComponent* AttachTo = nullptr, const FTransform& Transform = FTransform::Identity,
+        const FName SocketName = NAME_None, TSubclassOf<T> ComponentClass = T::StaticClass())
+    {
+        static_assert(TIsDerivedFrom<T, UActorComponent>::Value, "Pooled components must derive from UActorComponent");
+        return static_cast<T*>(AcquireComponentFromPool(ComponentClass, AttachTo, Transform, SocketName));
+    }
+
+    template<typename T>
+    T* AcquireObject(TSubclassOf<T> ObjectClass = T::StaticClass())
+    {
+        return static_cast<T*>(AcquireObjectFromPool(ObjectClass));
+    }
+
+    /**
+     * Lets projectiles of a pooled actor class fly as records, stepped in one batch per frame and drawn through an instanced
+     * static mesh, until a hit or gameplay needs the actor. Registering a class again updates its config.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Projectiles")
+    bool RegisterProjectileClass(TSubclassOf<AActor> ActorClass, const FPooledProjectileConfig& Config);
+
+    /** Launches a projectile of a registered class as a record. A lifetime of 0 or less uses the class default. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Projectiles", meta = (AdvancedDisplay = "Lifetime"))
+    FPooledProjectileHandle LaunchProjectile(TSubclassOf<AActor> ActorClass, FVector Location, FVector Velocity, float Lifetime = 0.0f);
+
+    /**
+     * Turns a flying record into an actor from the pool, placed where the record is and moving with its velocity.
+     * @return Null for a stale handle, or when the pool cannot hand out an actor. The record then keeps flying and the handle stays valid.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Projectiles")
+    AActor* MaterializeProjectile(const FPooledProjectileHandle& Handle);
+
+    /** Hands the flight of an actor of a registered class back to a record and returns the actor to its pool. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Projectiles")
+    FPooledProjectileHandle DematerializeProjectile(AActor* Actor);
+
+    /** Drops a flying record without ever creating its actor. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Projectiles")
+    void DropProjectile(const FPooledProjectileHandle& Handle);
+
+    UFUNCTION(BlueprintPure, Category = "Object Pool|Projectiles")
+    bool IsProjectileHandleValid(const FPooledProjectileHandle& Handle) const;
+
+    /** Where a flying record currently is, false for a stale handle. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool|Projectiles")
+    bool GetProjectileLocation(const FPooledProjectileHandle& Handle, FVector& OutLocation) const;
+
+    /** The number of projectiles of the class currently flying as records. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool|Projectiles")
+    int32 GetNumProjectileRecords(TSubclassOf<AActor> ActorClass) const;
+
+    /**
+     * Dehydrates in-use actors of the class that are far from every viewer into mesh instances and returns them to the pool,
+     * and acquires them again once a viewer comes close. Registering a class again updates its distances and mesh.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool|Dehydration")
+    bool RegisterDehydrationClass(const FObjectPoolDehydrationClass& DehydrationClass);
+
+    /** The number of the class's actors currently held as mesh instances. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool|Dehydration")
+    int32 GetNumDehydratedActors(TSubclassOf<AActor> ActorClass) const;
+
     UFUNCTION(BlueprintPure, Category = "Object Pool")
-    int32 GetPoolSize(TSubclassOf<AActor> ClassType) const;
+    int32 GetPoolSize(TSubclassOf<UObject> ClassType) const;
+
+    /** Number of objects queued to be created for the pool over the next frames. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetPendingPoolGrowth(TSubclassOf<UObject> ClassType) const;
 
     UFUNCTION(BlueprintPure, Category = "Object Pool")
     float GetNextAutoShrinkTime() const { return NextShrinkTime; }
@@ -87,14 +570,57 @@ public:
     UFUNCTION(BlueprintPure, Category = "Object Pool")
     int32 GetMaximumPoolSize() const;
 
+    /** The maximum size of the class's pool, taking the per-class overrides into account. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetMaximumPoolSizeForClass(TSubclassOf<UObject> ClassType) const;
+
     UFUNCTION(BlueprintPure, Category = "Object Pool")
     int32 GetTotalShrinkOperations() const { return TotalShrinkOperations; }
 
     UFUNCTION(BlueprintPure, Category = "Object Pool")
-    int32 GetPoolGrowthOperation(TSubclassOf<AActor> ClassType) const;
+    int32 GetPoolGrowthOperation(TSubclassOf<UObject> ClassType) const;
+
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetPoolAccessCount(TSubclassOf<UObject> ClassType) const;
+
+    /** Idle actors the last shrink pass queued for destruction that have not been destroyed yet. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetPendingPoolShrink(TSubclassOf<UObject> ClassType) const;
 
+    /** Estimated memory owned by one instance of the class, 0 until the pool created its first one. */
     UFUNCTION(BlueprintPure, Category = "Object Pool")
-    int32 GetPoolAccessCount(TSubclassOf<AActor> ClassType) const;
+    int64 GetActorResidentBytes(TSubclassOf<UObject> ClassType) const;
+
+    /** Estimated memory owned by every instance in the class's pool. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int64 GetPoolResidentBytes(TSubclassOf<UObject> ClassType) const;
+
+    /** Estimated memory owned by all pooled actors, components and objects, the figure the memory budget is enforced against. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int64 GetTotalResidentBytes() const;
+
+    /** The number of idle actors in the class's pool currently held in the given tier. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetNumIdleActorsInTier(TSubclassOf<AActor> ClassType, EPooledActorIdleTier Tier) const;
+
+    /** Acquisitions that found no free actor in the pool and had to wait for a spawn. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetPoolMissCount(TSubclassOf<UObject> ClassType) const;
+
+    /** Misses the plain growth factor would have had on the same acquisitions, minus the actual misses. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    int32 GetPoolMissesAvoided(TSubclassOf<UObject> ClassType) const;
+
+    /** Creates and fills the pools listed in the manifest, the world's manifest from the project settings is applied automatically. */
+    UFUNCTION(BlueprintCallable, Category = "Object Pool")
+    void ApplyManifest(const UObjectPoolManifest* Manifest);
+
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    bool IsPrewarmComplete() const;
+
+    /** The fraction of prewarmed actors spawned so far, 1 when no prewarm is running. */
+    UFUNCTION(BlueprintPure, Category = "Object Pool")
+    float GetPrewarmProgress() const;
 
     UFUNCTION(BlueprintCallable, Category = "Object Pool")
     void ClearAllPools();
@@ -106,15 +632,90 @@ public:
     float GetTotalActorsInPoolRatio();
 
 private:
-    void ActivateActor(AActor* Actor);
-    void DeactivateActor(AActor* Actor);
-    void GrowActorPool(FObjectPool& Pool, TSubclassOf<AActor> ActorClass, int32 GrowthAmount);
-    void ShrinkPool(FObjectPool& Pool);
+    friend struct FLazyObjectPoolAsyncTickFunction;
+
+    const FObjectPool* FindPool(const UClass* ClassType) const;
+    const FPoolSlot* FindAcquiredSlot(const FPooledActorHandle& Handle) const;
+    int32 ReserveSlot(int32 PoolIndex, AActor* NewOwner);
+    // Releases the available slots at the tail whose objects were destroyed, until a live one is next in line.
+    void DropStaleAvailableSlots(int32 PoolIndex);
+    int32 ReserveSlots(int32 PoolIndex, int32 Count, AActor* NewOwner, TArray<int32>& OutSlotIndices);
+    int32 GetGrowthAmount(int32 PoolIndex, int32 MinimumGrowth) const;
+    int32 GetLegacyGrowthAmount(int32 NumInUse) const;
+    void ActivateSlot(FPoolSlotRef SlotRef, const FTransform& NewTransform, bool bSweep, FHitResult* OutSweepHitResult, ETeleportType Teleport);
+    void PlaceSlotActor(FPoolSlotRef SlotRef, const FTransform& NewTransform, bool bSweep, FHitResult* OutSweepHitResult, ETeleportType Teleport);
+    void ProcessPendingOverlapUpdates();
+    void SettleAsyncRequests();
+    int32 QueueAsyncAcquire(TSubclassOf<AActor> ActorClass, FPendingAsyncAcquire&& Request, float Timeout);
+    // Whether an id taken from a caller names an actor pool, logs an error for component and object pools.
+    bool IsActorPoolId(FObjectPoolId PoolId) const;
+    void ProcessAsyncAcquires();
+    void AbandonAsyncAcquires();
+    void PublishAsyncHeadroom(int32 PoolIndex);
+    void ProcessProjectileRecords(float DeltaTime);
+    FPooledProjectileHandle AddProjectileRecord(int32 ClassIndex, const FVector& Location, const FVector& Velocity, float Lifetime);
+    void RemoveProjectileRecord(int32 ClassIndex, int32 Record);
+    int32 FindProjectileRecord(const FPooledProjectileHandle& Handle) const;
+    void SyncProjectileRenderer(int32 ClassIndex);
+    AActor* MaterializeProjectileRecord(int32 ClassIndex, const FVector& Location, const FVector& Velocity, float RemainingLifetime, const FHitResult& Hit);
+    FPooledProjectileHandle ResumeProjectileRecord(AActor* Actor);
+    void ProcessDehydration();
+    void DehydrateActor(int32 DehydratedIndex, AActor* Actor);
+    void RehydrateActor(int32 DehydratedIndex, const FTransform& Transform, const TArray<uint8>& State, const TWeakObjectPtr<AActor>& OriginalActor);
+    void AddDehydratedActor(int32 DehydratedIndex, const FTransform& Transform, TArray<uint8>&& State, const TWeakObjectPtr<AActor>& OriginalActor);
+    void RemoveDehydratedActor(int32 DehydratedIndex, int32 Entry);
+    void ReturnSlotToPool(FPoolSlotRef SlotRef);
+    void DeactivateSlot(int32 PoolIndex, int32 SlotIndex);
+    int32 FindOrAddPoolIndex(const UClass* ClassType);
+    void GetActorsInSlotList(const FObjectPool& Pool, const FLazyPoolSlotList& List, TArray<AActor*>& OutActors) const;
+
+    void ActivateSlotActor(int32 PoolIndex, int32 SlotIndex);
+    void DeactivateSlotActor(int32 PoolIndex, int32 SlotIndex);
+    void ActivateActor(AActor* Actor, FActivationPlan Plan, TArrayView<UActorComponent* const> Components);
+    void DeactivateActor(AActor* Actor, FActivationPlan Plan, TArrayView<UActorComponent* const> Components);
+    void ActivatePooledComponent(UActorComponent* Component, FActivationPlan Plan);
+    void DeactivatePooledComponent(UActorComponent* Component, FActivationPlan Plan);
+    FActivationPlan GetActivationPlan(int32 PoolIndex);
+    void ProcessIdleTiers();
+    // Demotes the available actors idle for at least MinIdleTime, resuming after the cursor. False once the frame budget ran out.
+    bool ProcessIdleTier(int32 PoolIndex, EPooledActorIdleTier TargetTier, double MinIdleTime, FIdleTierCursor FObjectPool::* Cursor, double Now, double Deadline);
+    void DemoteSlotActor(int32 PoolIndex, int32 SlotIndex, EPooledActorIdleTier NewTier);
+    void WakeSlotActor(int32 PoolIndex, int32 SlotIndex);
+    void GrowActorPool(int32 PoolIndex, int32 GrowthAmount);
+    bool SpawnPooledObject(int32 PoolIndex);
+    bool SpawnPooledActor(int32 PoolIndex);
+    bool CreatePooledComponent(int32 PoolIndex);
+    bool CreatePooledUObject(int32 PoolIndex);
+    int32 AddPooledObject(int32 PoolIndex, UObject* Object, TArray<UActorComponent*>&& Components);
+    // Resolves the components of a slot's actor, dropping the ones destroyed since the actor spawned.
+    void GatherSlotComponents(int32 PoolIndex, int32 SlotIndex, TInlineComponentArray<UActorComponent*>& OutComponents);
+    void RequestPoolGrowth(int32 PoolIndex, int32 GrowthAmount);
+    void UpdatePoolDemand(float DeltaTime);
+    void RecordAcquisitions(int32 PoolIndex, int32 Count);
+    FObjectPoolDemandStats GetDemandStats(int32 PoolIndex) const;
+    void ProcessPendingGrowth();
+    void ProcessPendingShrink();
+    void EnforceMemoryBudget();
+    // Bytes left under the memory budget after the growth every pool has queued, unlimited without a budget.
+    int64 GetMemoryHeadroomBytes() const;
+    int32 FindEvictionCandidate() const;
+    int64 EstimateResidentBytes(UObject* Object) const;
+    void UpdatePrewarmProgress();
+    void PrewarmPool(int32 PoolIndex, int32 PoolSize, bool bBlocking);
+    void PrewarmFromDemandProfile();
+    void SaveDemandProfile() const;
+    int32 GetProfiledInitialSize(const UClass* ClassType) const;
+    int32 GetInitialSize(int32 PoolIndex) const;
+    const UObjectPoolManifest* LoadManifestForWorld(const UWorld& InWorld) const;
+    int32 GetMaxGrowth(int32 PoolIndex, int32 GrowthAmount) const;
+    void ShrinkPool(int32 PoolIndex);
+    void DestroyPooledObject(int32 PoolIndex, int32 SlotIndex);
     void PerformAutoShrink();
-    
+
     UFUNCTION()
     void HandleActorDestroyed(AActor* DestroyedActor);
-    
-    void LogPoolOperation(const FString& Operation, TSubclassOf<AActor> ClassType) const;
+
+    // Publishes the available and in-use count of every pool to Unreal Insights while the trace channel is on.
+    void UpdateTraceCounters();
     void CalculateNextShrinkTime();
-};
\ No newline at end of file
+};
@@ -0,0 +1,220 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "LazyDynamicObjectPoolTypes.generated.h"
+
+class UStaticMesh;
+
+/**
+ * @enum EPooledActorIdleTier
+ * @brief How much of an idle pooled actor is kept live, deeper tiers are cheaper to hold and slower to acquire.
+ */
+UENUM(BlueprintType)
+enum class EPooledActorIdleTier : uint8
+{
+    /** Hidden with collision and tick off, ready to be handed out immediately. */
+    Warm,
+    /** Components unregistered, so the actor has nothing in the render or physics scene. */
+    Cold,
+    /** Cold, with the actor's tick functions unregistered from the level, and the actor asked to release its heavy per-instance resources. */
+    Hibernated
+};
+
+/**
+ * @enum EPooledActorParkingMode
+ * @brief Where an actor waits while it sits in the pool.
+ */
+UENUM(BlueprintType)
+enum class EPooledActorParkingMode : uint8
+{
+    /** Stays where it was returned, hidden with collision off. */
+    None,
+    /** Moved to the parking location, away from anything gameplay or the camera is near. */
+    Isolated,
+    /** Components unregistered on return, so idle actors add nothing to the render scene or the physics broadphase. */
+    Unregistered
+};
+
+/**
+ * @enum EPooledActorOverlapMode
+ * @brief When an acquired actor's overlaps are brought up to date with its new location.
+ */
+UENUM(BlueprintType)
+enum class EPooledActorOverlapMode : uint8
+{
+    /** During the acquire, in the same scene update as the placement and the collision re-enable. */
+    Immediate,
+    /** On the subsystem's next tick, so a burst of acquisitions does not pay for its overlap queries on the calling frame. */
+    Deferred,
+    /** Not at all, begin overlap events only fire once the actor moves. Suits actors that never start inside something. */
+    Skip
+};
+
+/**
+ * @struct FPooledActorHandle
+ * @brief Identifies one acquisition of a pooled actor.
+ *
+ * A handle is issued when an actor is acquired from the pool and goes stale as soon as that actor is
+ * returned, so holding on to it can never reach an actor that has since been handed to someone else.
+ * Validating a handle against the subsystem costs a couple of integer compares.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FPooledActorHandle
+{
+    GENERATED_BODY()
+
+    FPooledActorHandle() = default;
+    FPooledActorHandle(const int32 InPoolIndex, const int32 InSlotIndex, const uint32 InGeneration)
+        : PoolIndex(InPoolIndex), SlotIndex(InSlotIndex), Generation(InGeneration)
+    {}
+
+    /** @brief Whether this handle was ever issued, it says nothing about whether it is still current. */
+    bool IsSet() const { return PoolIndex != INDEX_NONE && SlotIndex != INDEX_NONE; }
+
+    int32 GetPoolIndex() const { return PoolIndex; }
+    int32 GetSlotIndex() const { return SlotIndex; }
+    uint32 GetGeneration() const { return Generation; }
+
+    bool operator==(const FPooledActorHandle& Other) const
+    {
+        return PoolIndex == Other.PoolIndex && SlotIndex == Other.SlotIndex && Generation == Other.Generation;
+    }
+    bool operator!=(const FPooledActorHandle& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FPooledActorHandle& Handle)
+    {
+        return HashCombine(HashCombine(::GetTypeHash(Handle.PoolIndex), ::GetTypeHash(Handle.SlotIndex)), ::GetTypeHash(Handle.Generation));
+    }
+
+private:
+    UPROPERTY()
+    int32 PoolIndex = INDEX_NONE;
+
+    UPROPERTY()
+    int32 SlotIndex = INDEX_NONE;
+
+    UPROPERTY()
+    uint32 Generation = 0;
+};
+
+/**
+ * @struct FPooledProjectileConfig
+ * @brief How projectiles of a registered class fly, collide and are drawn while they are records rather than actors.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FPooledProjectileConfig
+{
+    GENERATED_BODY()
+
+    /** @brief Drawn through one instanced static mesh component per class, at each record's position facing its velocity. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    UStaticMesh* Mesh = nullptr;
+
+    /** @brief Fraction of the world gravity applied to records every step, 0 flies straight. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    float GravityScale = 0.0f;
+
+    /** @brief Seconds a record flies before it is dropped, used when a launch does not give its own lifetime. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool", meta = (ClampMin = "0.01", UIMin = "0.01"))
+    float DefaultLifetime = 3.0f;
+
+    /** @brief Trace each record along its step and turn it into an actor from the pool when the trace hits something. A full pool keeps the record at the hit point and retries next frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    bool bMaterializeOnHit = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool", meta = (EditCondition = "bMaterializeOnHit"))
+    TEnumAsByte<ECollisionChannel> TraceChannel = ECC_WorldDynamic;
+
+    /**
+     * @brief Returning a materialised actor hands its flight back to a record instead of ending it.
+     * @note Suits actors materialised for a closer look rather than for a hit. DematerializeProjectile does this for a single actor either way.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Object Pool")
+    bool bDematerializeOnReturn = false;
+};
+
+/**
+ * @struct FPooledProjectileHandle
+ * @brief Identifies one projectile while it flies as a record, stale once it is materialised, dematerialised into a new record or dropped.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FPooledProjectileHandle
+{
+    GENERATED_BODY()
+
+    FPooledProjectileHandle() = default;
+    FPooledProjectileHandle(const int32 InClassIndex, const int32 InId, const uint32 InGeneration)
+        : ClassIndex(InClassIndex), Id(InId), Generation(InGeneration)
+    {}
+
+    bool IsSet() const { return ClassIndex != INDEX_NONE && Id != INDEX_NONE; }
+
+    int32 GetClassIndex() const { return ClassIndex; }
+    int32 GetId() const { return Id; }
+    uint32 GetGeneration() const { return Generation; }
+
+    bool operator==(const FPooledProjectileHandle& Other) const
+    {
+        return ClassIndex == Other.ClassIndex && Id == Other.Id && Generation == Other.Generation;
+    }
+    bool operator!=(const FPooledProjectileHandle& Other) const { return !(*this == Other); }
+
+private:
+    UPROPERTY()
+    int32 ClassIndex = INDEX_NONE;
+
+    UPROPERTY()
+    int32 Id = INDEX_NONE;
+
+    UPROPERTY()
+    uint32 Generation = 0;
+};
+
+/**
+ * @struct FObjectPoolId
+ * @brief Dense index of a pool inside the subsystem that resolved it.
+ *
+ * Pools are never removed once created, so an id resolved once can be kept and reused for the lifetime
+ * of the world and lets the hot path skip the class lookup entirely.
+ */
+USTRUCT(BlueprintType)
+struct LAZYGENERICDYNAMICOBJECTPOOL_API FObjectPoolId
+{
+    GENERATED_BODY()
+
+    FObjectPoolId() = default;
+    explicit FObjectPoolId(const int32 InIndex) : Index(InIndex) {}
+
+    bool IsSet() const { return Index != INDEX_NONE; }
+    int32 GetIndex() const { return Index; }
+
+    bool operator==(const FObjectPoolId& Other) const { return Index == Other.Index; }
+    bool operator!=(const FObjectPoolId& Other) const { return Index != Other.Index; }
+
+    friend uint32 GetTypeHash(const FObjectPoolId& Id) { return ::GetTypeHash(Id.Index); }
+
+private:
+    UPROPERTY()
+    int32 Index = INDEX_NONE;
+};
+
+/**
+ * @struct TPoolRef
+ * @brief Typed wrapper around a resolved pool id, obtained from ULazyDynamicObjectPoolSubsystem::ResolvePool.
+ */
+template<typename T>
+struct TPoolRef
+{
+    TPoolRef() = default;
+    explicit TPoolRef(const FObjectPoolId InPoolId) : PoolId(InPoolId) {}
+
+    bool IsSet() const { return PoolId.IsSet(); }
+    explicit operator bool() const { return IsSet(); }
+    FObjectPoolId GetPoolId() const { return PoolId; }
+
+private:
+    FObjectPoolId PoolId;
+};
@@ -4,34 +4,131 @@
 #include "FunctionLibrary\LazyDynamicObjectPoolUnCookOnlyLibrary.h"
 #include "BlueprintCompilationManager.h"
 #include "K2Node_CallArrayFunction.h"
+#include "K2Node_DynamicCast.h"
 #include "K2Node_EnumLiteral.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_TemporaryVariable.h"
+#include "K2Node_VariableSet.h"
 #include "KismetCompiler.h"
+#include "Components/ActorComponent.h"
+#include "Kismet/KismetSystemLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "FunctionLibrary/LazyDynamicObjectPoolLibrary.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
 
 DEFINE_LOG_CATEGORY(LogLazyDynamicObjectPoolEditor);
 
+namespace LazyDynamicObjectPoolUnCookOnly
+{
+    static const FName ObjectParamName(TEXT("Object"));
+    static const FName ValueParamName(TEXT("Value"));
+    static const FName PropertyNameParamName(TEXT("PropertyName"));
+
+    // Whether a graph outside the variable's class may write it with a plain variable-set node
+    static bool CanSetDirectly(const FProperty* Property)
+    {
+        return Property->HasAllPropertyFlags(CPF_BlueprintVisible)
+            && !Property->HasAnyPropertyFlags(CPF_BlueprintReadOnly)
+            && !Property->GetBoolMetaData(FBlueprintMetadata::MD_Private)
+            && !Property->GetBoolMetaData(FBlueprintMetadata::MD_Protected);
+    }
+
+    static UFunction* FindSetterFunction(const UClass* ForClass, const FProperty* Property)
+    {
+        const FString& SetterName = Property->GetMetaData(FBlueprintMetadata::MD_PropertySetFunction);
+        return SetterName.IsEmpty() ? nullptr : ForClass->FindFunctionByName(*SetterName);
+    }
+
+    // Last resort for variables the graph may not write, the generic setter looks the property up by name on every call
+    static UK2Node_CallFunction* SpawnSetByNameNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphNode* SpawnPoolNode,
+        UEdGraphPin* OrgPin, UEdGraphPin* ObjectPin)
+    {
+        const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+        const UFunction* SetByNameFunction = Schema->FindSetVariableByNameFunction(OrgPin->PinType);
+        if (!SetByNameFunction) return nullptr;
+
+        UK2Node_CallFunction* SetVarNode = nullptr;
+        if (OrgPin->PinType.IsArray())
+        {
+            SetVarNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallArrayFunction>(SpawnPoolNode, SourceGraph);
+        }
+        else
+        {
+            SetVarNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+        }
+
+        SetVarNode->SetFromFunction(SetByNameFunction);
+        SetVarNode->AllocateDefaultPins();
+
+        ObjectPin->MakeLinkTo(SetVarNode->FindPinChecked(ObjectParamName));
+
+        UEdGraphPin* PropertyNamePin = SetVarNode->FindPinChecked(PropertyNameParamName);
+        PropertyNamePin->DefaultValue = OrgPin->PinName.ToString();
+
+        UEdGraphPin* ValuePin = SetVarNode->FindPinChecked(ValueParamName);
+
+        if (OrgPin->LinkedTo.Num() == 0 &&
+        OrgPin->DefaultValue != FString() &&
+        OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte &&
+        OrgPin->PinType.PinSubCategoryObject.IsValid() &&
+        OrgPin->PinType.PinSubCategoryObject->IsA<UEnum>())
+        {
+            // Pin is an enum, we need to alias the enum value to an int:
+            UK2Node_EnumLiteral* EnumLiteralNode = CompilerContext.SpawnIntermediateNode<UK2Node_EnumLiteral>(SetVarNode, SourceGraph);
+            EnumLiteralNode->Enum = CastChecked<UEnum>(OrgPin->PinType.PinSubCategoryObject.Get());
+            EnumLiteralNode->AllocateDefaultPins();
+            EnumLiteralNode->FindPinChecked(UEdGraphSchema_K2::PN_ReturnValue)->MakeLinkTo(ValuePin);
+
+            UEdGraphPin* InPin = EnumLiteralNode->FindPinChecked(UK2Node_EnumLiteral::GetEnumInputPinName());
+            check( InPin );
+            InPin->DefaultValue = OrgPin->DefaultValue;
+        }
+        else
+        {
+            // For non-array struct pins that are not linked, transfer the pin type so that the node will expand an auto-ref that will assign the value by-ref.
+            if (OrgPin->PinType.IsArray() == false && OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && OrgPin->LinkedTo.Num() == 0)
+            {
+                ValuePin->PinType.PinCategory = OrgPin->PinType.PinCategory;
+                ValuePin->PinType.PinSubCategory = OrgPin->PinType.PinSubCategory;
+                ValuePin->PinType.PinSubCategoryObject = OrgPin->PinType.PinSubCategoryObject;
+                CompilerContext.MovePinLinksToIntermediate(*OrgPin, *ValuePin);
+            }
+            else
+            {
+                // For interface pins we need to copy over the subcategory
+                if (OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Interface)
+                {
+                    ValuePin->PinType.PinSubCategoryObject = OrgPin->PinType.PinSubCategoryObject;
+                }
+
+                CompilerContext.MovePinLinksToIntermediate(*OrgPin, *ValuePin);
+                SetVarNode->PinConnectionListChanged(ValuePin);
+            }
+        }
+        SetVarNode->PinConnectionListChanged(ValuePin);
+        return SetVarNode;
+    }
+}
+
 ULazyDynamicObjectPoolUnCookOnlyLibrary::ULazyDynamicObjectPoolUnCookOnlyLibrary(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {}
 
-UEdGraphPin* ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesForPoolActor(FKismetCompilerContext& CompilerContext,
-    UEdGraph* SourceGraph, const UK2Node_CallFunction* GetActorFromPoolNode, UEdGraphNode* SpawnPoolNode,
-    UEdGraphPin* PoolActorPin, const UClass* ForClass)
+void ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesForPoolActor(FKismetCompilerContext& CompilerContext,
+    UEdGraph* SourceGraph, const UEdGraphNode* GetActorFromPoolNode, UEdGraphPin* FirstThen, UEdGraphPin* NextExec,
+    UEdGraphNode* SpawnPoolNode, UEdGraphPin* PoolActorPin, const UClass* ForClass)
 {
-    static const FName ObjectParamName(TEXT("Object"));
-    static const FName ValueParamName(TEXT("Value"));
-    static const FName PropertyNameParamName(TEXT("PropertyName"));
+    using namespace LazyDynamicObjectPoolUnCookOnly;
 
     const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
     if (!Schema)
     {
         CompilerContext.MessageLog.Error(TEXT("Schema is null"));
-        return nullptr;
+        return;
     }
 
-    UEdGraphPin* LastThen = GetActorFromPoolNode->GetThenPin();
-
-    // Create 'set var by name' nodes and hook them up
+    // Collect the pins that carry a value different from the class default
+    TArray<TPair<UEdGraphPin*, const FProperty*>> Assignments;
     for (int32 PinIdx = 0; PinIdx < SpawnPoolNode->Pins.Num(); PinIdx++)
     {
         UEdGraphPin* OrgPin = SpawnPoolNode->Pins[PinIdx];
@@ -56,74 +153,128 @@ UEdGraphPin* ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesFor
                 }
             }
 
-            UK2Node_CallFunction* SetVarNode = nullptr;
-            if (OrgPin->PinType.IsArray())
-            {
-                SetVarNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallArrayFunction>(SpawnPoolNode, SourceGraph);
-            }
-            else
-            {
-                SetVarNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
-            }
-
-            const UFunction* SetByNameFunction = Schema->FindSetVariableByNameFunction(OrgPin->PinType);
-            if (!SetByNameFunction) continue;
+            Assignments.Emplace(OrgPin, Property);
+        }
+    }
 
-            SetVarNode->SetFromFunction(SetByNameFunction);
-            SetVarNode->AllocateDefaultPins();
+    if (Assignments.IsEmpty())
+    {
+        FirstThen->MakeLinkTo(NextExec);
+        return;
+    }
 
-            Schema->TryCreateConnection(LastThen, SetVarNode->GetExecPin());
-            LastThen = SetVarNode->GetThenPin();
+    // A full pool hands out null, the assignments are skipped instead of each reporting an access to None
+    UK2Node_CallFunction* IsValidNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+    IsValidNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, IsValid), UKismetSystemLibrary::StaticClass());
+    IsValidNode->AllocateDefaultPins();
+    PoolActorPin->MakeLinkTo(IsValidNode->FindPinChecked(ObjectParamName));
 
-            UEdGraphPin* ObjectPin = SetVarNode->FindPinChecked(ObjectParamName);
-            PoolActorPin->MakeLinkTo(ObjectPin);
+    UK2Node_IfThenElse* BranchNode = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(SpawnPoolNode, SourceGraph);
+    BranchNode->AllocateDefaultPins();
+    FirstThen->MakeLinkTo(BranchNode->GetExecPin());
+    IsValidNode->GetReturnValuePin()->MakeLinkTo(BranchNode->GetConditionPin());
+    BranchNode->GetElsePin()->MakeLinkTo(NextExec);
+    UEdGraphPin* LastThen = BranchNode->GetThenPin();
 
-            UEdGraphPin* PropertyNamePin = SetVarNode->FindPinChecked(PropertyNameParamName);
-            PropertyNamePin->DefaultValue = OrgPin->PinName.ToString();
+    // Direct sets need the actor typed as the spawned class, an actor pin typed as AActor goes through a single cast
+    UEdGraphPin* TypedActorPin = PoolActorPin;
+    const UClass* ActorPinClass = Cast<UClass>(PoolActorPin->PinType.PinSubCategoryObject.Get());
+    if (!ActorPinClass || !ActorPinClass->IsChildOf(ForClass))
+    {
+        UK2Node_DynamicCast* CastNode = CompilerContext.SpawnIntermediateNode<UK2Node_DynamicCast>(SpawnPoolNode, SourceGraph);
+        CastNode->TargetType = const_cast<UClass*>(ForClass);
+        CastNode->SetPurity(false);
+        CastNode->AllocateDefaultPins();
+        PoolActorPin->MakeLinkTo(CastNode->GetCastSourcePin());
+        LastThen->MakeLinkTo(CastNode->GetExecPin());
+        CastNode->GetInvalidCastPin()->MakeLinkTo(NextExec);
+        LastThen = CastNode->GetValidCastPin();
+        TypedActorPin = CastNode->GetCastResultPin();
+    }
 
-            UEdGraphPin* ValuePin = SetVarNode->FindPinChecked(ValueParamName);
+    for (const TPair<UEdGraphPin*, const FProperty*>& Assignment : Assignments)
+    {
+        UEdGraphPin* OrgPin = Assignment.Key;
+        const FProperty* Property = Assignment.Value;
 
-            if (OrgPin->LinkedTo.Num() == 0 &&
-            OrgPin->DefaultValue != FString() &&
-            OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte &&
-            OrgPin->PinType.PinSubCategoryObject.IsValid() &&
-            OrgPin->PinType.PinSubCategoryObject->IsA<UEnum>())
-            {
-                // Pin is an enum, we need to alias the enum value to an int:
-                UK2Node_EnumLiteral* EnumLiteralNode = CompilerContext.SpawnIntermediateNode<UK2Node_EnumLiteral>(SetVarNode, SourceGraph);
-                EnumLiteralNode->Enum = CastChecked<UEnum>(OrgPin->PinType.PinSubCategoryObject.Get());
-                EnumLiteralNode->AllocateDefaultPins();
-                EnumLiteralNode->FindPinChecked(UEdGraphSchema_K2::PN_ReturnValue)->MakeLinkTo(ValuePin);
-
-                UEdGraphPin* InPin = EnumLiteralNode->FindPinChecked(UK2Node_EnumLiteral::GetEnumInputPinName());
-                check( InPin );
-                InPin->DefaultValue = OrgPin->DefaultValue;
-            }
-            else
+        UK2Node* SetNode = nullptr;
+        UEdGraphPin* ValuePin = nullptr;
+        if (UFunction* SetterFunction = FindSetterFunction(ForClass, Property))
+        {
+            UK2Node_CallFunction* SetterNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+            SetterNode->SetFromFunction(SetterFunction);
+            SetterNode->AllocateDefaultPins();
+            for (UEdGraphPin* Pin : SetterNode->Pins)
             {
-                // For non-array struct pins that are not linked, transfer the pin type so that the node will expand an auto-ref that will assign the value by-ref.
-                if (OrgPin->PinType.IsArray() == false && OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct && OrgPin->LinkedTo.Num() == 0)
+                if (Pin->Direction == EGPD_Input && Pin->PinName != UEdGraphSchema_K2::PN_Self && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
                 {
-                    ValuePin->PinType.PinCategory = OrgPin->PinType.PinCategory;
-                    ValuePin->PinType.PinSubCategory = OrgPin->PinType.PinSubCategory;
-                    ValuePin->PinType.PinSubCategoryObject = OrgPin->PinType.PinSubCategoryObject;
-                    CompilerContext.MovePinLinksToIntermediate(*OrgPin, *ValuePin);
-                }
-                else
-                {
-                    // For interface pins we need to copy over the subcategory
-                    if (OrgPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Interface)
-                    {
-                        ValuePin->PinType.PinSubCategoryObject = OrgPin->PinType.PinSubCategoryObject;
-                    }
-
-                    CompilerContext.MovePinLinksToIntermediate(*OrgPin, *ValuePin);
-                    SetVarNode->PinConnectionListChanged(ValuePin);
+                    ValuePin = Pin;
+                    break;
                 }
             }
-            SetVarNode->PinConnectionListChanged(ValuePin);
+            SetNode = SetterNode;
+        }
+        else if (CanSetDirectly(Property))
+        {
+            UK2Node_VariableSet* VariableSetNode = CompilerContext.SpawnIntermediateNode<UK2Node_VariableSet>(SpawnPoolNode, SourceGraph);
+            VariableSetNode->VariableReference.SetFromField<FProperty>(Property, false);
+            VariableSetNode->AllocateDefaultPins();
+            ValuePin = VariableSetNode->FindPin(Property->GetFName(), EGPD_Input);
+            SetNode = VariableSetNode;
+        }
+
+        if (SetNode && ValuePin)
+        {
+            TypedActorPin->MakeLinkTo(SetNode->FindPinChecked(UEdGraphSchema_K2::PN_Self));
+            CompilerContext.MovePinLinksToIntermediate(*OrgPin, *ValuePin);
+        }
+        else
+        {
+            SetNode = SpawnSetByNameNode(CompilerContext, SourceGraph, SpawnPoolNode, OrgPin, TypedActorPin);
+            if (!SetNode) continue;
         }
+
+        Schema->TryCreateConnection(LastThen, SetNode->GetExecPin());
+        LastThen = SetNode->GetThenPin();
+    }
+
+    LastThen->MakeLinkTo(NextExec);
+}
+
+UK2Node_CallFunction* ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateCachedPoolNodes(FKismetCompilerContext& CompilerContext,
+    UEdGraph* SourceGraph, UEdGraphNode* SpawnPoolNode, UEdGraphPin* WorldContextPin, UClass* ForClass,
+    UEdGraphPin*& OutSubsystemPin, UEdGraphPin*& OutPoolIdPin)
+{
+    // Only event graph temporaries persist between executions, and only actors and their components are sure to never
+    // outlive the world whose subsystem they cached. Elsewhere the temporaries start out empty on every execution.
+    const UClass* ParentClass = CompilerContext.Blueprint ? CompilerContext.Blueprint->ParentClass : nullptr;
+    const bool bPersistent = SourceGraph == CompilerContext.ConsolidatedEventGraph && ParentClass
+        && (ParentClass->IsChildOf(AActor::StaticClass()) || ParentClass->IsChildOf(UActorComponent::StaticClass()));
+
+    UK2Node_TemporaryVariable* SubsystemVariableNode = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(SpawnPoolNode, SourceGraph);
+    SubsystemVariableNode->VariableType.PinCategory = UEdGraphSchema_K2::PC_Object;
+    SubsystemVariableNode->VariableType.PinSubCategoryObject = ULazyDynamicObjectPoolSubsystem::StaticClass();
+    SubsystemVariableNode->bIsPersistent = bPersistent;
+    SubsystemVariableNode->AllocateDefaultPins();
+
+    UK2Node_TemporaryVariable* PoolIdVariableNode = CompilerContext.SpawnIntermediateNode<UK2Node_TemporaryVariable>(SpawnPoolNode, SourceGraph);
+    PoolIdVariableNode->VariableType.PinCategory = UEdGraphSchema_K2::PC_Struct;
+    PoolIdVariableNode->VariableType.PinSubCategoryObject = FObjectPoolId::StaticStruct();
+    PoolIdVariableNode->bIsPersistent = bPersistent;
+    PoolIdVariableNode->AllocateDefaultPins();
+
+    UK2Node_CallFunction* ResolveNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+    ResolveNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolLibrary, ResolvePoolCached), ULazyDynamicObjectPoolLibrary::StaticClass());
+    ResolveNode->AllocateDefaultPins();
+    if (WorldContextPin)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*WorldContextPin, *ResolveNode->FindPinChecked(TEXT("ContextObject")));
     }
+    ResolveNode->FindPinChecked(TEXT("ActorClass"))->DefaultObject = ForClass;
+    SubsystemVariableNode->GetVariablePin()->MakeLinkTo(ResolveNode->FindPinChecked(TEXT("Subsystem"), EGPD_Input));
+    PoolIdVariableNode->GetVariablePin()->MakeLinkTo(ResolveNode->FindPinChecked(TEXT("PoolId"), EGPD_Input));
 
-    return LastThen;
+    OutSubsystemPin = ResolveNode->GetReturnValuePin();
+    OutPoolIdPin = ForClass ? PoolIdVariableNode->GetVariablePin() : nullptr;
+    return ResolveNode;
 }
@@ -8,7 +8,6 @@
 #include "KismetCompiler.h"
 #include "KismetCompilerMisc.h"
 #include "FunctionLibrary\LazyDynamicObjectPoolUnCookOnlyLibrary.h"
-#include "FunctionLibrary/LazyDynamicObjectPoolLibrary.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
 
@@ -18,11 +17,17 @@ struct FK2Nod_SpawnActorFromPoolHelper
     static const FName ActorClassPinName;
     static const FName ActorClassTransformPinName;
     static const FName OwnerPinName;
+    static const FName SweepPinName;
+    static const FName TeleportPinName;
+    static const FName SweepHitResultPinName;
 };
 
 const FName FK2Nod_SpawnActorFromPoolHelper::ActorClassPinName(TEXT("ActorClass"));
 const FName FK2Nod_SpawnActorFromPoolHelper::ActorClassTransformPinName(TEXT("SpawnTransform"));
 const FName FK2Nod_SpawnActorFromPoolHelper::OwnerPinName(TEXT("Owner"));
+const FName FK2Nod_SpawnActorFromPoolHelper::SweepPinName(TEXT("bSweep"));
+const FName FK2Nod_SpawnActorFromPoolHelper::TeleportPinName(TEXT("bTeleport"));
+const FName FK2Nod_SpawnActorFromPoolHelper::SweepHitResultPinName(TEXT("SweepHitResult"));
 
 #define LOCTEXT_NAMESPACE "K2Node_GetActorFromPool"
 
@@ -36,6 +41,22 @@ void UK2Node_SpawnActorFromPool::AllocateDefaultPins()
 
     UEdGraphPin* OwnerPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, AActor::StaticClass(), FK2Nod_SpawnActorFromPoolHelper::OwnerPinName);
     OwnerPin->bAdvancedView = true;
+
+    // Placement options forwarded to FinishInitializeActorFromPool
+    UEdGraphPin* SweepPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, FK2Nod_SpawnActorFromPoolHelper::SweepPinName);
+    SweepPin->DefaultValue = TEXT("false");
+    SweepPin->PinToolTip = LOCTEXT("SweepPin_Tooltip", "Whether to sweep from where the actor was returned to the spawn transform, actors parked in isolation are always teleported.").ToString();
+    SweepPin->bAdvancedView = true;
+
+    UEdGraphPin* TeleportPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, FK2Nod_SpawnActorFromPoolHelper::TeleportPinName);
+    TeleportPin->DefaultValue = TEXT("false");
+    TeleportPin->PinToolTip = LOCTEXT("TeleportPin_Tooltip", "Whether physics should treat the placement as a teleport instead of deriving a velocity from it.").ToString();
+    TeleportPin->bAdvancedView = true;
+
+    UScriptStruct* HitResultStruct = FHitResult::StaticStruct();
+    UEdGraphPin* SweepHitResultPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Struct, HitResultStruct, FK2Nod_SpawnActorFromPoolHelper::SweepHitResultPinName);
+    SweepHitResultPin->bAdvancedView = true;
+
     if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
     {
         AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
@@ -46,18 +67,6 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
 {
     Super::ExpandNode(CompilerContext, SourceGraph);
 
-    // Create the "Get Subsystem" node
-    UEdGraphPin* WorldContextPin = nullptr;
-    const UK2Node_CallFunction* GetSubsystemNode = CreateGetSubsystemNode(CompilerContext, SourceGraph, WorldContextPin);
-    if(!IsValid(GetSubsystemNode)) return;
-    UEdGraphPin* SubsystemInstancePin = GetSubsystemNode->GetReturnValuePin();
-
-    // Connect the WorldContext pin
-    if (UEdGraphPin* MyWorldContextPin = GetWorldContextPin())
-    {
-        CompilerContext.MovePinLinksToIntermediate(*MyWorldContextPin, *WorldContextPin);
-    }
-
     UK2Node_SpawnActorFromPool* SpawnPoolNode = this;
     UEdGraphPin* ExecPin = SpawnPoolNode->GetExecPin();
     UEdGraphPin* ThenPin = SpawnPoolNode->GetThenPin();
@@ -65,6 +74,9 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
     UEdGraphPin* SpawnWorldContextPin = SpawnPoolNode->GetWorldContextPin();
     UEdGraphPin* TransformPin = SpawnPoolNode->GetActorTransformPin();
     UEdGraphPin* OwnerPin = SpawnPoolNode->GetOwnerPin();
+    UEdGraphPin* SweepPin = SpawnPoolNode->FindPin(FK2Nod_SpawnActorFromPoolHelper::SweepPinName);
+    UEdGraphPin* TeleportPin = SpawnPoolNode->FindPin(FK2Nod_SpawnActorFromPoolHelper::TeleportPinName);
+    UEdGraphPin* SweepHitResultPin = SpawnPoolNode->FindPin(FK2Nod_SpawnActorFromPoolHelper::SweepHitResultPinName);
     UEdGraphPin* ResultPin = SpawnPoolNode->GetResultPin();
 
     // Cache the class to spawn. Note, this is the compile time class that the pin was set to or the variable type it was connected to. Runtime it could be a child.
@@ -79,35 +91,52 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
         return;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    // resolve the subsystem, and the pool of a class picked on the node, once instead of on every spawn
+    const bool bClassIsLiteral = ClassPin->LinkedTo.Num() == 0;
+    UEdGraphPin* SubsystemInstancePin = nullptr;
+    UEdGraphPin* PoolIdPin = nullptr;
+    UK2Node_CallFunction* ResolvePoolNode = ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateCachedPoolNodes(CompilerContext, SourceGraph, SpawnPoolNode,
+        SpawnWorldContextPin, bClassIsLiteral ? SpawnClass : nullptr, SubsystemInstancePin, PoolIdPin);
+    CompilerContext.MovePinLinksToIntermediate(*ExecPin, *ResolvePoolNode->GetExecPin());
+
     //////////////////////////////////////////////////////////////////////////
     // create 'begin spawn' call node
     UK2Node_CallFunction* GetActorFromPoolFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
-    GetActorFromPoolFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, InitializeActorFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
-    GetActorFromPoolFunc->AllocateDefaultPins();
-
-    UEdGraphPin* CallActorFromPoolExec = GetActorFromPoolFunc->GetExecPin();
-    UEdGraphPin* CallActorFromPoolActorClassPin = GetActorFromPoolFunc->FindPinChecked(FName("ActorClass"));
-    UEdGraphPin* CallActorFromPoolOwnerPin = GetActorFromPoolFunc->FindPinChecked(FName("NewOwner"));
-    UEdGraphPin* CallActorFromPoolResult = GetActorFromPoolFunc->GetReturnValuePin();	
-    
-    // Move 'exec' connection from spawn node to 'initialise actor'
-    CompilerContext.MovePinLinksToIntermediate(*ExecPin, *CallActorFromPoolExec);
-
-    // Connect the GetSubsystem node to...
-    UEdGraphPin* CallActorFromPoolTargetPin = GetActorFromPoolFunc->FindPinChecked(UEdGraphSchema_K2::PN_Self);
-    CallActorFromPoolTargetPin->MakeLinkTo( SubsystemInstancePin );
-
-    if(ClassPin->LinkedTo.Num() > 0)
+    if (PoolIdPin)
     {
-        // Copy the 'blueprint' connection from the spawn node to 'begin spawn'
-        CompilerContext.MovePinLinksToIntermediate(*ClassPin, *CallActorFromPoolActorClassPin);
+        GetActorFromPoolFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, InitializeActorFromPoolId), ULazyDynamicObjectPoolSubsystem::StaticClass());
+        GetActorFromPoolFunc->AllocateDefaultPins();
+        PoolIdPin->MakeLinkTo(GetActorFromPoolFunc->FindPinChecked(FName("PoolId")));
     }
     else
     {
-        // Copy blueprint literal onto begin spawn call 
-        CallActorFromPoolActorClassPin->DefaultObject = SpawnClass;
+        GetActorFromPoolFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, InitializeActorFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
+        GetActorFromPoolFunc->AllocateDefaultPins();
+
+        UEdGraphPin* CallActorFromPoolActorClassPin = GetActorFromPoolFunc->FindPinChecked(FName("ActorClass"));
+        if (ClassPin->LinkedTo.Num() > 0)
+        {
+            // Copy the 'blueprint' connection from the spawn node to 'begin spawn'
+            CompilerContext.MovePinLinksToIntermediate(*ClassPin, *CallActorFromPoolActorClassPin);
+        }
+        else
+        {
+            // Copy blueprint literal onto begin spawn call
+            CallActorFromPoolActorClassPin->DefaultObject = SpawnClass;
+        }
     }
 
+    UEdGraphPin* CallActorFromPoolExec = GetActorFromPoolFunc->GetExecPin();
+    UEdGraphPin* CallActorFromPoolOwnerPin = GetActorFromPoolFunc->FindPinChecked(FName("NewOwner"));
+    UEdGraphPin* CallActorFromPoolResult = GetActorFromPoolFunc->GetReturnValuePin();
+
+    // The pool only hands out instances of the class, typing the result as such lets the exposed variables be set directly
+    CallActorFromPoolResult->PinType = ResultPin->PinType;
+
+    ResolvePoolNode->GetThenPin()->MakeLinkTo(CallActorFromPoolExec);
+    GetActorFromPoolFunc->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(SubsystemInstancePin);
+
     if (OwnerPin != nullptr)
     {
         CompilerContext.MovePinLinksToIntermediate(*OwnerPin, *CallActorFromPoolOwnerPin);
@@ -116,15 +145,17 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
     //////////////////////////////////////////////////////////////////////////
     // create 'Finish Initialize Actor' call node
     UK2Node_CallFunction* CallFinishInitializeActorNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
-    CallFinishInitializeActorNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, FinishInitializeActorFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
+    CallFinishInitializeActorNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, K2_FinishInitializeActorFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
     CallFinishInitializeActorNode->AllocateDefaultPins();
 
     UEdGraphPin* CallFinishActorFromPoolExec = CallFinishInitializeActorNode->GetExecPin();
     UEdGraphPin* CallFinishActorFromPoolThen = CallFinishInitializeActorNode->GetThenPin();
     UEdGraphPin* CallFinishActorFromPoolActor = CallFinishInitializeActorNode->FindPinChecked(FName("Actor"));
     UEdGraphPin* CallFinishActorFromPoolTransform = CallFinishInitializeActorNode->FindPinChecked(FName("NewTransform"));
+    UEdGraphPin* CallFinishActorFromPoolSweep = CallFinishInitializeActorNode->FindPinChecked(FName("bSweep"));
+    UEdGraphPin* CallFinishActorFromPoolTeleport = CallFinishInitializeActorNode->FindPinChecked(FName("bTeleport"));
+    UEdGraphPin* CallFinishActorFromPoolSweepHitResult = CallFinishInitializeActorNode->FindPinChecked(FName("SweepHitResult"));
     UEdGraphPin* CallFinishActorFromPoolResult = CallFinishInitializeActorNode->GetReturnValuePin();
-    // add more for bsweep,OutSweepHitResult and teleport.
 
     UEdGraphPin* CallFinishActorFromPoolTargetPin = CallFinishInitializeActorNode->FindPinChecked(UEdGraphSchema_K2::PN_Self);
     CallFinishActorFromPoolTargetPin->MakeLinkTo( SubsystemInstancePin );
@@ -135,6 +166,19 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
     // Copy transform connection
     CompilerContext.CopyPinLinksToIntermediate(*TransformPin, *CallFinishActorFromPoolTransform);
 
+    if (SweepPin != nullptr)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*SweepPin, *CallFinishActorFromPoolSweep);
+    }
+    if (TeleportPin != nullptr)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*TeleportPin, *CallFinishActorFromPoolTeleport);
+    }
+    if (SweepHitResultPin != nullptr)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*SweepHitResultPin, *CallFinishActorFromPoolSweepHitResult);
+    }
+
     // Connect output actor from 'init' to 'finish init'
     CallActorFromPoolResult->MakeLinkTo(CallFinishActorFromPoolActor);
 
@@ -142,12 +186,9 @@ void UK2Node_SpawnActorFromPool::ExpandNode(FKismetCompilerContext& CompilerCont
     CallFinishActorFromPoolResult->PinType = ResultPin->PinType; // Copy type so it uses the right actor subclass
     CompilerContext.MovePinLinksToIntermediate(*ResultPin, *CallFinishActorFromPoolResult);
 
-    // Get 'result' pin from 'begin spawn', this is the actual actor we want to set properties on
-    /*UEdGraphPin* LastThen = FKismetCompilerUtilities::GenerateAssignmentNodes(CompilerContext, SourceGraph, GetActorFromPoolFunc, SpawnPoolNode, CallActorFromPoolResult, ClassToSpawn );*/
-    UEdGraphPin* LastThen = ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesForPoolActor(CompilerContext, SourceGraph, GetActorFromPoolFunc, SpawnPoolNode, CallActorFromPoolResult, ClassToSpawn);
-
-    // Make exec connection between 'then' on last node and 'finish'
-    LastThen->MakeLinkTo(CallFinishActorFromPoolExec);
+    // Set the exposed variables on the actor from 'begin spawn' between it and 'finish'
+    ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesForPoolActor(CompilerContext, SourceGraph, GetActorFromPoolFunc,
+        GetActorFromPoolFunc->GetThenPin(), CallFinishActorFromPoolExec, SpawnPoolNode, CallActorFromPoolResult, ClassToSpawn);
 
     // Break any links to the expanded node
     SpawnPoolNode->BreakAllNodeLinks();
@@ -251,18 +292,10 @@ bool UK2Node_SpawnActorFromPool::IsSpawnVarPin(UEdGraphPin* Pin) const
 
     return(	Super::IsSpawnVarPin(Pin) &&
             Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::ActorClassTransformPinName && 
-            Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::OwnerPinName );
+            Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::OwnerPinName &&
+            Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::SweepPinName &&
+            Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::TeleportPinName &&
+            Pin->PinName != FK2Nod_SpawnActorFromPoolHelper::SweepHitResultPinName );
 }
 
-UK2Node_CallFunction* UK2Node_SpawnActorFromPool::CreateGetSubsystemNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphPin*& OutWorldContextPin)
-{
-    UK2Node_CallFunction* GetSubsystemNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-    GetSubsystemNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolLibrary, GetSubsystem), ULazyDynamicObjectPoolLibrary::StaticClass());
-    GetSubsystemNode->AllocateDefaultPins();
-    
-    return GetSubsystemNode;
-}
-
-
-
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,318 @@
+// // Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "UEd/K2Node_SpawnActorFromPoolAsync.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_AddDelegate.h"
+#include "K2Node_BaseAsyncTask.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+#include "AsyncActions/SpawnActorFromPoolAsyncAction.h"
+#include "FunctionLibrary/LazyDynamicObjectPoolUnCookOnlyLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+
+struct FK2Node_SpawnActorFromPoolAsyncHelper
+{
+    //static pins
+    static const FName ActorTransformPinName;
+    static const FName OwnerPinName;
+    static const FName TimeoutPinName;
+    static const FName PriorityPinName;
+    static const FName OnSpawnedPinName;
+    static const FName OnFailedPinName;
+};
+
+// Timeout and priority are prefixed so they cannot shadow a variable of the spawned class
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::ActorTransformPinName(TEXT("SpawnTransform"));
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::OwnerPinName(TEXT("Owner"));
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::TimeoutPinName(TEXT("AcquireTimeout"));
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::PriorityPinName(TEXT("AcquirePriority"));
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::OnSpawnedPinName(TEXT("OnSpawned"));
+const FName FK2Node_SpawnActorFromPoolAsyncHelper::OnFailedPinName(TEXT("OnFailed"));
+
+#define LOCTEXT_NAMESPACE "K2Node_SpawnActorFromPoolAsync"
+
+void UK2Node_SpawnActorFromPoolAsync::AllocateDefaultPins()
+{
+    Super::AllocateDefaultPins();
+
+    // Then fires right away, the actor arrives on OnSpawned
+    CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, FK2Node_SpawnActorFromPoolAsyncHelper::OnSpawnedPinName);
+    CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, FK2Node_SpawnActorFromPoolAsyncHelper::OnFailedPinName);
+
+    UScriptStruct* TransformStruct = TBaseStructure<FTransform>::Get();
+    CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, TransformStruct, FK2Node_SpawnActorFromPoolAsyncHelper::ActorTransformPinName);
+
+    UEdGraphPin* OwnerPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, AActor::StaticClass(), FK2Node_SpawnActorFromPoolAsyncHelper::OwnerPinName);
+    OwnerPin->bAdvancedView = true;
+
+    UEdGraphPin* TimeoutPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Real, UEdGraphSchema_K2::PC_Float, FK2Node_SpawnActorFromPoolAsyncHelper::TimeoutPinName);
+    TimeoutPin->DefaultValue = TEXT("0.0");
+    TimeoutPin->PinToolTip = LOCTEXT("TimeoutPin_Tooltip", "Seconds to wait for the pool before On Failed fires, 0 waits forever.").ToString();
+    TimeoutPin->bAdvancedView = true;
+
+    UEdGraphPin* PriorityPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, FK2Node_SpawnActorFromPoolAsyncHelper::PriorityPinName);
+    PriorityPin->DefaultValue = TEXT("0");
+    PriorityPin->PinToolTip = LOCTEXT("PriorityPin_Tooltip", "Waiting requests for the same pool with a higher priority are served first.").ToString();
+    PriorityPin->bAdvancedView = true;
+
+    if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
+    {
+        AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+    }
+}
+
+void UK2Node_SpawnActorFromPoolAsync::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+    Super::ExpandNode(CompilerContext, SourceGraph);
+
+    const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+    UEdGraphPin* ExecPin = GetExecPin();
+    UEdGraphPin* ThenPin = GetThenPin();
+    UEdGraphPin* ClassPin = GetClassPin();
+    UEdGraphPin* ResultPin = GetResultPin();
+
+    // Cache the class to spawn. Note, this is the compile time class that the pin was set to or the variable type it was connected to. Runtime it could be a child.
+    UClass* ClassToSpawn = GetClassToSpawn();
+
+    UClass* SpawnClass = (ClassPin != nullptr) ? Cast<UClass>(ClassPin->DefaultObject) : nullptr;
+    if (!ClassPin || ((0 == ClassPin->LinkedTo.Num()) && (nullptr == SpawnClass)))
+    {
+        CompilerContext.MessageLog.Error(*LOCTEXT("SpawnActorFromPoolAsyncMissingClass_Error", "Spawn Actor From Pool (Async) node @@ must have a @@ specified.").ToString(), this, ClassPin);
+        BreakAllNodeLinks();
+        return;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // create the proxy that waits on the pool
+    UK2Node_CallFunction* CreateProxyNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+    CreateProxyNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(USpawnActorFromPoolAsyncAction, InitializeActorFromPoolAsync), USpawnActorFromPoolAsyncAction::StaticClass());
+    CreateProxyNode->AllocateDefaultPins();
+
+    UEdGraphPin* ProxyActorClassPin = CreateProxyNode->FindPinChecked(FName("ActorClass"));
+    UEdGraphPin* ProxyPin = CreateProxyNode->GetReturnValuePin();
+
+    CompilerContext.MovePinLinksToIntermediate(*ExecPin, *CreateProxyNode->GetExecPin());
+    if (UEdGraphPin* MyWorldContextPin = GetWorldContextPin())
+    {
+        CompilerContext.MovePinLinksToIntermediate(*MyWorldContextPin, *CreateProxyNode->FindPinChecked(FName("WorldContextObject")));
+    }
+
+    if (ClassPin->LinkedTo.Num() > 0)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*ClassPin, *ProxyActorClassPin);
+    }
+    else
+    {
+        ProxyActorClassPin->DefaultObject = SpawnClass;
+    }
+
+    CompilerContext.MovePinLinksToIntermediate(*GetOwnerPin(), *CreateProxyNode->FindPinChecked(FName("Owner")));
+    CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::TimeoutPinName), *CreateProxyNode->FindPinChecked(FName("Timeout")));
+    CompilerContext.MovePinLinksToIntermediate(*FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::PriorityPinName), *CreateProxyNode->FindPinChecked(FName("Priority")));
+
+    //////////////////////////////////////////////////////////////////////////
+    // bind an event to each of the proxy's delegates
+    bool bIsErrorFree = true;
+    UEdGraphPin* LastThen = CreateProxyNode->GetThenPin();
+    auto BindProxyDelegate = [&](const FName DelegateName, UEdGraphPin* OutputPin) -> UK2Node_CustomEvent*
+    {
+        FMulticastDelegateProperty* DelegateProperty = FindFProperty<FMulticastDelegateProperty>(USpawnActorFromPoolAsyncAction::StaticClass(), DelegateName);
+        check(DelegateProperty);
+
+        UK2Node_AddDelegate* AddDelegateNode = CompilerContext.SpawnIntermediateNode<UK2Node_AddDelegate>(this, SourceGraph);
+        AddDelegateNode->SetFromProperty(DelegateProperty, false, DelegateProperty->GetOwnerClass());
+        AddDelegateNode->AllocateDefaultPins();
+        bIsErrorFree &= Schema->TryCreateConnection(AddDelegateNode->FindPinChecked(UEdGraphSchema_K2::PN_Self), ProxyPin);
+        bIsErrorFree &= Schema->TryCreateConnection(LastThen, AddDelegateNode->FindPinChecked(UEdGraphSchema_K2::PN_Execute));
+        LastThen = AddDelegateNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+        UK2Node_CustomEvent* EventNode = CompilerContext.SpawnIntermediateEventNode<UK2Node_CustomEvent>(this, OutputPin, SourceGraph);
+        EventNode->CustomFunctionName = *FString::Printf(TEXT("%s_%s"), *DelegateName.ToString(), *CompilerContext.GetGuid(this));
+        EventNode->AllocateDefaultPins();
+        bIsErrorFree &= FBaseAsyncTaskHelper::CreateDelegateForNewFunction(AddDelegateNode->GetDelegatePin(), EventNode->GetFunctionName(), this, SourceGraph, CompilerContext);
+        bIsErrorFree &= FBaseAsyncTaskHelper::CopyEventSignature(EventNode, AddDelegateNode->GetDelegateSignature(), Schema);
+        return EventNode;
+    };
+
+    UEdGraphPin* OnSpawnedPin = GetOnSpawnedPin();
+    UEdGraphPin* OnFailedPin = GetOnFailedPin();
+    UK2Node_CustomEvent* SpawnedEventNode = BindProxyDelegate(GET_MEMBER_NAME_CHECKED(USpawnActorFromPoolAsyncAction, OnSpawned), OnSpawnedPin);
+    UK2Node_CustomEvent* FailedEventNode = BindProxyDelegate(GET_MEMBER_NAME_CHECKED(USpawnActorFromPoolAsyncAction, OnFailed), OnFailedPin);
+
+    //////////////////////////////////////////////////////////////////////////
+    // activate the proxy once both events are bound, then continue on 'then'
+    UK2Node_CallFunction* ActivateNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+    ActivateNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(UBlueprintAsyncActionBase, Activate), UBlueprintAsyncActionBase::StaticClass());
+    ActivateNode->AllocateDefaultPins();
+    bIsErrorFree &= Schema->TryCreateConnection(ActivateNode->FindPinChecked(UEdGraphSchema_K2::PN_Self), ProxyPin);
+    bIsErrorFree &= Schema->TryCreateConnection(LastThen, ActivateNode->GetExecPin());
+    CompilerContext.MovePinLinksToIntermediate(*ThenPin, *ActivateNode->GetThenPin());
+
+    //////////////////////////////////////////////////////////////////////////
+    // on spawned: set the exposed variables on the reserved actor, then finish initializing it
+    UEdGraphPin* SpawnedActorPin = SpawnedEventNode->FindPinChecked(FName("Actor"));
+
+    UEdGraphPin* SubsystemInstancePin = nullptr;
+    UEdGraphPin* PoolIdPin = nullptr;
+    UK2Node_CallFunction* ResolvePoolNode = ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateCachedPoolNodes(CompilerContext, SourceGraph, this,
+        nullptr, nullptr, SubsystemInstancePin, PoolIdPin);
+    SpawnedEventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then)->MakeLinkTo(ResolvePoolNode->GetExecPin());
+
+    UK2Node_CallFunction* CallFinishInitializeActorNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+    CallFinishInitializeActorNode->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, K2_FinishInitializeActorFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
+    CallFinishInitializeActorNode->AllocateDefaultPins();
+
+    CallFinishInitializeActorNode->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(SubsystemInstancePin);
+    SpawnedActorPin->MakeLinkTo(CallFinishInitializeActorNode->FindPinChecked(FName("Actor")));
+    CompilerContext.MovePinLinksToIntermediate(*GetActorTransformPin(), *CallFinishInitializeActorNode->FindPinChecked(FName("NewTransform")));
+
+    UEdGraphPin* CallFinishActorFromPoolResult = CallFinishInitializeActorNode->GetReturnValuePin();
+    CallFinishActorFromPoolResult->PinType = ResultPin->PinType; // Copy type so it uses the right actor subclass
+    CompilerContext.MovePinLinksToIntermediate(*ResultPin, *CallFinishActorFromPoolResult);
+    CompilerContext.MovePinLinksToIntermediate(*OnSpawnedPin, *CallFinishInitializeActorNode->GetThenPin());
+
+    ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateAssignmentNodesForPoolActor(CompilerContext, SourceGraph, SpawnedEventNode,
+        ResolvePoolNode->GetThenPin(), CallFinishInitializeActorNode->GetExecPin(), this, SpawnedActorPin, ClassToSpawn);
+
+    //////////////////////////////////////////////////////////////////////////
+    // on failed: nothing to finish
+    CompilerContext.MovePinLinksToIntermediate(*OnFailedPin, *FailedEventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then));
+
+    if (!bIsErrorFree)
+    {
+        CompilerContext.MessageLog.Error(*LOCTEXT("SpawnActorFromPoolAsyncInternalError", "Spawn Actor From Pool (Async) node @@ could not be expanded.").ToString(), this);
+    }
+
+    // Break any links to the expanded node
+    BreakAllNodeLinks();
+}
+
+FText UK2Node_SpawnActorFromPoolAsync::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    const UEdGraphPin* ClassPin = GetClassPin();
+    if (!ClassPin)
+    {
+        return LOCTEXT("K2Node_SpawnActorFromPoolAsync_NodeTitle_Default", "Spawn Actor From Pool (Async)");
+    }
+
+    FText ClassName = FText::FromString(TEXT("NONE"));
+    if (const UClass* PickedClass = Cast<UClass>(ClassPin->DefaultObject))
+    {
+        ClassName = PickedClass->GetDisplayNameText();
+    }
+
+    return FText::Format(LOCTEXT("K2Node_SpawnActorFromPoolAsync_NodeTitle_Format", "Spawn {0} From Pool (Async)"), ClassName);
+}
+
+FText UK2Node_SpawnActorFromPoolAsync::GetTooltipText() const
+{
+    return LOCTEXT("SpawnActorFromPoolAsync_Tooltip", "Spawns an actor from the object pool once one is free or has finished spawning, On Failed fires if the timeout runs out first");
+}
+
+FSlateIcon UK2Node_SpawnActorFromPoolAsync::GetIconAndTint(FLinearColor& OutColor) const
+{
+    static FSlateIcon Icon("EditorStyle", "ClassIcon.Actor");
+    return Icon;
+}
+
+bool UK2Node_SpawnActorFromPoolAsync::IsCompatibleWithGraph(UEdGraph const* Graph) const
+{
+    // Latent, so only event graphs can wait on it
+    const UEdGraphSchema_K2* K2Schema = Cast<UEdGraphSchema_K2>(Graph->GetSchema());
+    if (!K2Schema || K2Schema->GetGraphType(Graph) != GT_Ubergraph) return false;
+
+    const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+    return Super::IsCompatibleWithGraph(Graph) && (!Blueprint || Blueprint->GeneratedClass->GetDefaultObject()->ImplementsGetWorld());
+}
+
+void UK2Node_SpawnActorFromPoolAsync::GetNodeAttributes(TArray<TKeyValuePair<FString, FString>>& OutNodeAttributes) const
+{
+    const UClass* ClassToSpawn = GetClassToSpawn();
+    const FString ClassToSpawnStr = ClassToSpawn ? ClassToSpawn->GetName() : TEXT( "InvalidClass" );
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Type" ), TEXT( "SpawnActorFromClass" ) ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Class" ), GetClass()->GetName() ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Name" ), GetName() ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "ActorClass" ), ClassToSpawnStr ));
+}
+
+FNodeHandlingFunctor* UK2Node_SpawnActorFromPoolAsync::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FNodeHandlingFunctor(CompilerContext);
+}
+
+void UK2Node_SpawnActorFromPoolAsync::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    const UClass* ActionKey = GetClass();
+    if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+    {
+        UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+        check(NodeSpawner != nullptr);
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+FText UK2Node_SpawnActorFromPoolAsync::GetMenuCategory() const
+{
+    return LOCTEXT("SpawnActorFromPoolAsync_MenuCategory", "Object Pool");
+}
+
+UClass* UK2Node_SpawnActorFromPoolAsync::GetClassPinBaseClass() const
+{
+    return AActor::StaticClass();
+}
+
+UEdGraphPin* UK2Node_SpawnActorFromPoolAsync::GetActorTransformPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::ActorTransformPinName);
+    check(Pin->Direction == EGPD_Input);
+    return Pin;
+}
+
+UEdGraphPin* UK2Node_SpawnActorFromPoolAsync::GetOwnerPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::OwnerPinName);
+    check(Pin->Direction == EGPD_Input);
+    return Pin;
+}
+
+UEdGraphPin* UK2Node_SpawnActorFromPoolAsync::GetOnSpawnedPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::OnSpawnedPinName);
+    check(Pin->Direction == EGPD_Output);
+    return Pin;
+}
+
+UEdGraphPin* UK2Node_SpawnActorFromPoolAsync::GetOnFailedPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorFromPoolAsyncHelper::OnFailedPinName);
+    check(Pin->Direction == EGPD_Output);
+    return Pin;
+}
+
+bool UK2Node_SpawnActorFromPoolAsync::IsSpawnVarPin(UEdGraphPin* Pin) const
+{
+    const UEdGraphPin* ParentPin = Pin->ParentPin;
+    while (ParentPin)
+    {
+        if (ParentPin->PinName == FK2Node_SpawnActorFromPoolAsyncHelper::ActorTransformPinName)
+        {
+            return false;
+        }
+        ParentPin = ParentPin->ParentPin;
+    }
+
+    return(	Super::IsSpawnVarPin(Pin) &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::ActorTransformPinName &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::OwnerPinName &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::TimeoutPinName &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::PriorityPinName &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::OnSpawnedPinName &&
+            Pin->PinName != FK2Node_SpawnActorFromPoolAsyncHelper::OnFailedPinName );
+}
+
+#undef LOCTEXT_NAMESPACE
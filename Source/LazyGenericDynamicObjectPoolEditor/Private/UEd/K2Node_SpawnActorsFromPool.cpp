@@ -0,0 +1,246 @@
+// // Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "UEd/K2Node_SpawnActorsFromPool.h"
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "KismetCompilerMisc.h"
+#include "FunctionLibrary/LazyDynamicObjectPoolUnCookOnlyLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+
+struct FK2Node_SpawnActorsFromPoolHelper
+{
+    //static pins
+    static const FName CountPinName;
+    static const FName ActorTransformsPinName;
+    static const FName OwnerPinName;
+};
+
+const FName FK2Node_SpawnActorsFromPoolHelper::CountPinName(TEXT("Count"));
+const FName FK2Node_SpawnActorsFromPoolHelper::ActorTransformsPinName(TEXT("SpawnTransforms"));
+const FName FK2Node_SpawnActorsFromPoolHelper::OwnerPinName(TEXT("Owner"));
+
+#define LOCTEXT_NAMESPACE "K2Node_SpawnActorsFromPool"
+
+void UK2Node_SpawnActorsFromPool::AllocateDefaultPins()
+{
+    Super::AllocateDefaultPins();
+
+    UEdGraphPin* CountPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, FK2Node_SpawnActorsFromPoolHelper::CountPinName);
+    CountPin->DefaultValue = TEXT("1");
+
+    // One transform per actor, or a single transform shared by all of them
+    FCreatePinParams TransformsPinParams;
+    TransformsPinParams.ContainerType = EPinContainerType::Array;
+    TransformsPinParams.bIsReference = true;
+    TransformsPinParams.bIsConst = true;
+    CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, TBaseStructure<FTransform>::Get(), FK2Node_SpawnActorsFromPoolHelper::ActorTransformsPinName, TransformsPinParams);
+
+    UEdGraphPin* OwnerPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, AActor::StaticClass(), FK2Node_SpawnActorsFromPoolHelper::OwnerPinName);
+    OwnerPin->bAdvancedView = true;
+    if (ENodeAdvancedPins::NoPins == AdvancedPinDisplay)
+    {
+        AdvancedPinDisplay = ENodeAdvancedPins::Hidden;
+    }
+
+    // The spawned actors come out as an array of the picked class
+    GetResultPin()->PinType.ContainerType = EPinContainerType::Array;
+}
+
+void UK2Node_SpawnActorsFromPool::CreatePinsForClass(UClass* InClass, TArray<UEdGraphPin*>* OutClassPins)
+{
+    // Every actor in the batch would share the same values, so no exposed-on-spawn pins are created,
+    // only the result type follows the picked class.
+    if (UEdGraphPin* ResultPin = GetResultPin())
+    {
+        ResultPin->PinType.PinSubCategoryObject = InClass ? InClass->GetAuthoritativeClass() : GetClassPinBaseClass();
+    }
+}
+
+void UK2Node_SpawnActorsFromPool::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+    Super::ExpandNode(CompilerContext, SourceGraph);
+
+    UK2Node_SpawnActorsFromPool* SpawnPoolNode = this;
+    UEdGraphPin* ExecPin = SpawnPoolNode->GetExecPin();
+    UEdGraphPin* ThenPin = SpawnPoolNode->GetThenPin();
+    UEdGraphPin* ClassPin = SpawnPoolNode->GetClassPin();
+    UEdGraphPin* CountPin = SpawnPoolNode->GetCountPin();
+    UEdGraphPin* TransformsPin = SpawnPoolNode->GetActorTransformsPin();
+    UEdGraphPin* OwnerPin = SpawnPoolNode->GetOwnerPin();
+    UEdGraphPin* ResultPin = SpawnPoolNode->GetResultPin();
+
+    UClass* SpawnClass = (ClassPin != nullptr) ? Cast<UClass>(ClassPin->DefaultObject) : nullptr;
+    if ( !ClassPin || ((0 == ClassPin->LinkedTo.Num()) && (nullptr == SpawnClass)))
+    {
+        CompilerContext.MessageLog.Error(*LOCTEXT("SpawnActorsFromPoolMissingClass_Error", "Spawn Actors From Pool node @@ must have a @@ specified.").ToString(), SpawnPoolNode, ClassPin);
+        // we break exec links so this is the only error we get
+        SpawnPoolNode->BreakAllNodeLinks();
+        return;
+    }
+
+    // Resolve the subsystem once instead of on every spawn
+    UEdGraphPin* SubsystemInstancePin = nullptr;
+    UEdGraphPin* PoolIdPin = nullptr;
+    UK2Node_CallFunction* ResolvePoolNode = ULazyDynamicObjectPoolUnCookOnlyLibrary::GenerateCachedPoolNodes(CompilerContext, SourceGraph, SpawnPoolNode,
+        GetWorldContextPin(), nullptr, SubsystemInstancePin, PoolIdPin);
+
+    //////////////////////////////////////////////////////////////////////////
+    // create 'Initialize Actors' call node
+    UK2Node_CallFunction* InitializeActorsFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+    InitializeActorsFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, InitializeActorsFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
+    InitializeActorsFunc->AllocateDefaultPins();
+
+    UEdGraphPin* CallInitializeExec = InitializeActorsFunc->GetExecPin();
+    UEdGraphPin* CallInitializeActorClassPin = InitializeActorsFunc->FindPinChecked(FName("ActorClass"));
+    UEdGraphPin* CallInitializeCountPin = InitializeActorsFunc->FindPinChecked(FName("Count"));
+    UEdGraphPin* CallInitializeOwnerPin = InitializeActorsFunc->FindPinChecked(FName("NewOwner"));
+    UEdGraphPin* CallInitializeResult = InitializeActorsFunc->GetReturnValuePin();
+
+    CompilerContext.MovePinLinksToIntermediate(*ExecPin, *ResolvePoolNode->GetExecPin());
+    ResolvePoolNode->GetThenPin()->MakeLinkTo(CallInitializeExec);
+    InitializeActorsFunc->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(SubsystemInstancePin);
+
+    if(ClassPin->LinkedTo.Num() > 0)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*ClassPin, *CallInitializeActorClassPin);
+    }
+    else
+    {
+        CallInitializeActorClassPin->DefaultObject = SpawnClass;
+    }
+
+    CompilerContext.MovePinLinksToIntermediate(*CountPin, *CallInitializeCountPin);
+
+    if (OwnerPin != nullptr)
+    {
+        CompilerContext.MovePinLinksToIntermediate(*OwnerPin, *CallInitializeOwnerPin);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // create 'Finish Initialize Actors' call node
+    UK2Node_CallFunction* FinishInitializeActorsFunc = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(SpawnPoolNode, SourceGraph);
+    FinishInitializeActorsFunc->FunctionReference.SetExternalMember(GET_FUNCTION_NAME_CHECKED(ULazyDynamicObjectPoolSubsystem, FinishInitializeActorsFromPool), ULazyDynamicObjectPoolSubsystem::StaticClass());
+    FinishInitializeActorsFunc->AllocateDefaultPins();
+
+    UEdGraphPin* CallFinishExec = FinishInitializeActorsFunc->GetExecPin();
+    UEdGraphPin* CallFinishThen = FinishInitializeActorsFunc->GetThenPin();
+    UEdGraphPin* CallFinishActors = FinishInitializeActorsFunc->FindPinChecked(FName("Actors"));
+    UEdGraphPin* CallFinishTransforms = FinishInitializeActorsFunc->FindPinChecked(FName("NewTransforms"));
+    UEdGraphPin* CallFinishResult = FinishInitializeActorsFunc->GetReturnValuePin();
+
+    FinishInitializeActorsFunc->FindPinChecked(UEdGraphSchema_K2::PN_Self)->MakeLinkTo(SubsystemInstancePin);
+
+    CallInitializeResult->MakeLinkTo(CallFinishActors);
+    InitializeActorsFunc->GetThenPin()->MakeLinkTo(CallFinishExec);
+    CompilerContext.MovePinLinksToIntermediate(*TransformsPin, *CallFinishTransforms);
+    CompilerContext.MovePinLinksToIntermediate(*ThenPin, *CallFinishThen);
+
+    // Copy type so the array uses the right actor subclass
+    CallFinishResult->PinType = ResultPin->PinType;
+    CompilerContext.MovePinLinksToIntermediate(*ResultPin, *CallFinishResult);
+
+    // Break any links to the expanded node
+    SpawnPoolNode->BreakAllNodeLinks();
+}
+
+FText UK2Node_SpawnActorsFromPool::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+    const UEdGraphPin* ClassPin = GetClassPin();
+    if (!ClassPin)
+    {
+        return LOCTEXT("K2Node_SpawnActorsFromPool_NodeTitle_Default", "Spawn Actors From Pool");
+    }
+
+    FText ClassName = FText::FromString(TEXT("NONE"));
+    if (const UClass* PickedClass = Cast<UClass>(ClassPin->DefaultObject))
+    {
+        ClassName = PickedClass->GetDisplayNameText();
+    }
+
+    return FText::Format(LOCTEXT("K2Node_SpawnActorsFromPool_NodeTitle_Format", "Spawn {0} Array From Pool"), ClassName);
+}
+
+FText UK2Node_SpawnActorsFromPool::GetTooltipText() const
+{
+    return LOCTEXT("SpawnActorsFromPool_Tooltip", "Spawns several actors from the object pool at once, growing the pool a single time if it does not hold enough actors");
+}
+
+FSlateIcon UK2Node_SpawnActorsFromPool::GetIconAndTint(FLinearColor& OutColor) const
+{
+    static FSlateIcon Icon("EditorStyle", "ClassIcon.Actor");
+    return Icon;
+}
+
+bool UK2Node_SpawnActorsFromPool::IsCompatibleWithGraph(UEdGraph const* Graph) const
+{
+    const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+    return Super::IsCompatibleWithGraph(Graph) && (!Blueprint || (FBlueprintEditorUtils::FindUserConstructionScript(Blueprint) != Graph && Blueprint->GeneratedClass->GetDefaultObject()->ImplementsGetWorld()));
+}
+
+void UK2Node_SpawnActorsFromPool::GetNodeAttributes(TArray<TKeyValuePair<FString, FString>>& OutNodeAttributes) const
+{
+    const UClass* ClassToSpawn = GetClassToSpawn();
+    const FString ClassToSpawnStr = ClassToSpawn ? ClassToSpawn->GetName() : TEXT( "InvalidClass" );
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Type" ), TEXT( "SpawnActorsFromClass" ) ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Class" ), GetClass()->GetName() ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "Name" ), GetName() ));
+    OutNodeAttributes.Add( TKeyValuePair<FString, FString>( TEXT( "ActorClass" ), ClassToSpawnStr ));
+}
+
+FNodeHandlingFunctor* UK2Node_SpawnActorsFromPool::CreateNodeHandler(FKismetCompilerContext& CompilerContext) const
+{
+    return new FNodeHandlingFunctor(CompilerContext);
+}
+
+void UK2Node_SpawnActorsFromPool::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+    const UClass* ActionKey = GetClass();
+    if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+    {
+        UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+        check(NodeSpawner != nullptr);
+        ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+    }
+}
+
+FText UK2Node_SpawnActorsFromPool::GetMenuCategory() const
+{
+    return LOCTEXT("SpawnActorsFromPool_MenuCategory", "Object Pool");
+}
+
+UClass* UK2Node_SpawnActorsFromPool::GetClassPinBaseClass() const
+{
+    return AActor::StaticClass();
+}
+
+bool UK2Node_SpawnActorsFromPool::IsSpawnVarPin(UEdGraphPin* Pin) const
+{
+    return false;
+}
+
+UEdGraphPin* UK2Node_SpawnActorsFromPool::GetCountPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorsFromPoolHelper::CountPinName);
+    check(Pin->Direction == EGPD_Input);
+    return Pin;
+}
+
+UEdGraphPin* UK2Node_SpawnActorsFromPool::GetActorTransformsPin() const
+{
+    UEdGraphPin* Pin = FindPinChecked(FK2Node_SpawnActorsFromPoolHelper::ActorTransformsPinName);
+    check(Pin->Direction == EGPD_Input);
+    return Pin;
+}
+
+UEdGraphPin* UK2Node_SpawnActorsFromPool::GetOwnerPin() const
+{
+    UEdGraphPin* Pin = FindPin(FK2Node_SpawnActorsFromPoolHelper::OwnerPinName);
+    check(Pin == nullptr || Pin->Direction == EGPD_Input);
+    return Pin;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -18,6 +18,20 @@ class LAZYGENERICDYNAMICOBJECTPOOLEDITOR_API ULazyDynamicObjectPoolUnCookOnlyLib
 {
 	GENERATED_UCLASS_BODY()
 
-	static UEdGraphPin* GenerateAssignmentNodesForPoolActor( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
-	const UK2Node_CallFunction* GetActorFromPoolNode, UEdGraphNode* SpawnPoolNode, UEdGraphPin* PoolActorPin, const UClass* ForClass );
+	/**
+	 * Sets the exposed-on-spawn variables of the pool actor, chained between FirstThen and NextExec. Variables the graph may write
+	 * get a direct variable-set node, or a call to their BlueprintSetter, so no property is looked up by name at runtime.
+	 * Read-only and private ones still go through the by-name setter. A null actor skips straight to NextExec.
+	 */
+	static void GenerateAssignmentNodesForPoolActor( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
+	const UEdGraphNode* GetActorFromPoolNode, UEdGraphPin* FirstThen, UEdGraphPin* NextExec, UEdGraphNode* SpawnPoolNode,
+	UEdGraphPin* PoolActorPin, const UClass* ForClass );
+
+	/**
+	 * Spawns the call that resolves the subsystem, and the pool of ForClass if given, into temporaries of the node. In event graphs
+	 * of actors and components the temporaries persist, so only the first execution resolves anything and later ones reuse them.
+	 * The caller wires the exec pins of the returned node. OutPoolIdPin is null without a class.
+	 */
+	static UK2Node_CallFunction* GenerateCachedPoolNodes( FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphNode* SpawnPoolNode,
+	UEdGraphPin* WorldContextPin, UClass* ForClass, UEdGraphPin*& OutSubsystemPin, UEdGraphPin*& OutPoolIdPin );
 };
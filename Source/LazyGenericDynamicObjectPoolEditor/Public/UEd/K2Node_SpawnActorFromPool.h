@@ -37,8 +37,6 @@ class LAZYGENERICDYNAMICOBJECTPOOLEDITOR_API UK2Node_SpawnActorFromPool : public
 	//~ Begin UK2Node_ConstructObjectFromClass Interface
 	virtual UClass* GetClassPinBaseClass() const override;
 	virtual bool IsSpawnVarPin(UEdGraphPin* Pin) const override;
-	UK2Node_CallFunction* CreateGetSubsystemNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph,
-	                                             UEdGraphPin*& OutWorldContextPin);
 	//~ End UK2Node_ConstructObjectFromClass Interface
 
 private:
@@ -0,0 +1,50 @@
+// // Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConstructObjectFromClass.h"
+#include "K2Node_SpawnActorFromPoolAsync.generated.h"
+
+/**
+ * Latent companion of UK2Node_SpawnActorFromPool. Waits until the pool can hand out an actor instead of failing
+ * when it is full, then sets the exposed-on-spawn variables and finishes initializing the actor before "On Spawned" fires.
+ */
+UCLASS()
+class LAZYGENERICDYNAMICOBJECTPOOLEDITOR_API UK2Node_SpawnActorFromPoolAsync : public UK2Node_ConstructObjectFromClass
+{
+	GENERATED_BODY()
+
+	//Start of UEdGraphNode interface implementation
+	virtual void AllocateDefaultPins() override;
+	virtual void ExpandNode(class FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual bool IsCompatibleWithGraph(UEdGraph const* Graph) const override;
+	//End of implementation
+
+	//~ Begin UK2Node Interface
+	virtual bool IsNodeSafeToIgnore() const override { return true; }
+	virtual bool IsLatentForMacros() const override { return true; }
+	virtual FName GetCornerIcon() const override { return TEXT("Graph.Latent.LatentIcon"); }
+	virtual void GetNodeAttributes( TArray<TKeyValuePair<FString, FString>>& OutNodeAttributes ) const override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	//~ End UK2Node Interface
+
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+
+	//~ Begin UK2Node_ConstructObjectFromClass Interface
+	virtual UClass* GetClassPinBaseClass() const override;
+	virtual bool IsSpawnVarPin(UEdGraphPin* Pin) const override;
+	//~ End UK2Node_ConstructObjectFromClass Interface
+
+private:
+	UEdGraphPin* GetActorTransformPin() const;
+	UEdGraphPin* GetOwnerPin() const;
+	UEdGraphPin* GetOnSpawnedPin() const;
+	UEdGraphPin* GetOnFailedPin() const;
+};
@@ -0,0 +1,27 @@
+﻿// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+using UnrealBuildTool;
+
+public class LazyGenericDynamicObjectPoolTests : ModuleRules
+{
+	public LazyGenericDynamicObjectPoolTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"LazyGenericDynamicObjectPool",
+			}
+			);
+	}
+}
@@ -0,0 +1,17 @@
+﻿// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "LazyGenericDynamicObjectPoolTests.h"
+
+#define LOCTEXT_NAMESPACE "FLazyGenericDynamicObjectPoolTestsModule"
+
+void FLazyGenericDynamicObjectPoolTestsModule::StartupModule()
+{
+}
+
+void FLazyGenericDynamicObjectPoolTestsModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FLazyGenericDynamicObjectPoolTestsModule, LazyGenericDynamicObjectPoolTests)
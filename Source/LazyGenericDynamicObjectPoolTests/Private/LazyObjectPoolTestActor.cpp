@@ -0,0 +1,32 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "LazyObjectPoolTestActor.h"
+#include "Components/BoxComponent.h"
+
+void ALazyObjectPoolTestActor::OnActivateFromPool_Implementation()
+{
+    NumActivations++;
+}
+
+void ALazyObjectPoolTestActor::OnDeactivateToPool_Implementation()
+{
+    NumDeactivations++;
+    if (OnDeactivated)
+    {
+        // Moved out first, the callback may run again if it returns the actor.
+        const TFunction<void(ALazyObjectPoolTestActor*)> Callback = MoveTemp(OnDeactivated);
+        Callback(this);
+    }
+}
+
+ALazyObjectPoolHeavyTestActor::ALazyObjectPoolHeavyTestActor()
+{
+    Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+    RootComponent = Box;
+
+    for (int32 i = 0; i < NumSceneComponents; ++i)
+    {
+        USceneComponent* SceneComponent = CreateDefaultSubobject<USceneComponent>(*FString::Printf(TEXT("SceneComponent%d"), i));
+        SceneComponent->SetupAttachment(Box);
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Interface/PoolableActorInterface.h"
+#include "LazyObjectPoolTestActor.generated.h"
+
+class UBoxComponent;
+
+/**
+ * @class ALazyObjectPoolTestActor
+ * @brief Pooled actor for the automation tests, counts its pool callbacks and lets a test run code from them.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class ALazyObjectPoolTestActor : public AActor, public IPoolableActorInterface
+{
+    GENERATED_BODY()
+
+public:
+    int32 NumActivations = 0;
+    int32 NumDeactivations = 0;
+
+    /** Runs from OnDeactivateToPool, for tests that re-enter the subsystem while the actor is being returned. */
+    TFunction<void(ALazyObjectPoolTestActor*)> OnDeactivated;
+
+    // Exposed on spawn the way a projectile's settings are, for the spawn node assignment benchmark.
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Damage = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Speed = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Lifetime = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Radius = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Bounces = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Pierce = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Team = 0;
+    UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn = "true"))
+    int32 Seed = 0;
+
+    virtual void OnActivateFromPool_Implementation() override;
+    virtual void OnDeactivateToPool_Implementation() override;
+};
+
+/**
+ * @class ALazyObjectPoolHeavyTestActor
+ * @brief Pooled actor without the pool interface, a collision box with NumSceneComponents scene components attached,
+ * for the benchmarks that need components to activate or primitives to park.
+ */
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class ALazyObjectPoolHeavyTestActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 NumSceneComponents = 23;
+
+    ALazyObjectPoolHeavyTestActor();
+
+    UPROPERTY()
+    TObjectPtr<UBoxComponent> Box;
+};
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "LazyObjectPoolTestWorld.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+FLazyObjectPoolTestWorld::FLazyObjectPoolTestWorld()
+{
+    World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("LazyObjectPoolTestWorld"));
+    World->AddToRoot();
+
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+}
+
+FLazyObjectPoolTestWorld::~FLazyObjectPoolTestWorld()
+{
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+}
+
+ULazyDynamicObjectPoolSubsystem* FLazyObjectPoolTestWorld::GetSubsystem() const
+{
+    return World->GetSubsystem<ULazyDynamicObjectPoolSubsystem>();
+}
+
+void FLazyObjectPoolTestWorld::Tick(const float DeltaTime) const
+{
+    World->Tick(LEVELTICK_All, DeltaTime);
+}
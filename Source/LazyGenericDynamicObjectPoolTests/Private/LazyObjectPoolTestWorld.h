@@ -0,0 +1,31 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class ULazyDynamicObjectPoolSubsystem;
+
+/**
+ * @class FLazyObjectPoolTestWorld
+ * @brief Game world with begun play and its pool subsystem, created for one test and torn down with it.
+ */
+class FLazyObjectPoolTestWorld
+{
+public:
+    FLazyObjectPoolTestWorld();
+    ~FLazyObjectPoolTestWorld();
+
+    FLazyObjectPoolTestWorld(const FLazyObjectPoolTestWorld&) = delete;
+    FLazyObjectPoolTestWorld& operator=(const FLazyObjectPoolTestWorld&) = delete;
+
+    UWorld* GetWorld() const { return World; }
+    ULazyDynamicObjectPoolSubsystem* GetSubsystem() const;
+
+    /** Ticks the world once, which runs the subsystem's tick and its async settle tick function. */
+    void Tick(float DeltaTime = 1.0f / 60.0f) const;
+
+private:
+    UWorld* World = nullptr;
+};
@@ -0,0 +1,267 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Subsystems/LazyDynamicObjectPoolAsyncAccess.h"
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+#include "LazyObjectPoolTestActor.h"
+#include "LazyObjectPoolTestWorld.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LazyObjectPoolAsyncAccessTests
+{
+    constexpr int32 PoolIndex = 3;
+
+    // Stands in for the subsystem: one pool's counters and the shared queues, with the given headroom published.
+    FObjectPoolAsyncAccess MakeAccess(const int32 Headroom, TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe>& OutCounters,
+        TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe>& OutQueues)
+    {
+        OutCounters = MakeShared<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe>();
+        OutCounters->Headroom.store(Headroom, std::memory_order_relaxed);
+        OutQueues = MakeShared<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe>();
+        return FObjectPoolAsyncAccess(PoolIndex, OutCounters, OutQueues);
+    }
+
+    // Runs Producer on NumThreads dedicated threads released at the same time. Returns the seconds until the last one finished.
+    double RunProducers(const int32 NumThreads, const TFunction<void(int32)>& Producer)
+    {
+        std::atomic<int32> NumReady { 0 };
+        std::atomic<bool> bStart { false };
+
+        TArray<TFuture<void>> Producers;
+        for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+        {
+            Producers.Add(Async(EAsyncExecution::Thread, [&Producer, &NumReady, &bStart, ThreadIndex]()
+            {
+                NumReady.fetch_add(1, std::memory_order_release);
+                while (!bStart.load(std::memory_order_acquire))
+                {
+                    FPlatformProcess::Yield();
+                }
+                Producer(ThreadIndex);
+            }));
+        }
+
+        while (NumReady.load(std::memory_order_acquire) < NumThreads)
+        {
+            FPlatformProcess::Yield();
+        }
+        const double StartTime = FPlatformTime::Seconds();
+        bStart.store(true, std::memory_order_release);
+        for (const TFuture<void>& Future : Producers)
+        {
+            Future.Wait();
+        }
+        return FPlatformTime::Seconds() - StartTime;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolAsyncAccessInvalidTest, "LazyGenericDynamicObjectPool.Subsystems.AsyncAccess.Invalid",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolAsyncAccessInvalidTest::RunTest(const FString& Parameters)
+{
+    const FObjectPoolAsyncAccess Access;
+    TestFalse(TEXT("A default access is invalid"), Access.IsValid());
+    TestFalse(TEXT("Claiming through an invalid access"), Access.TryClaimActor(FTransform::Identity, [](AActor*) {}));
+    TestEqual(TEXT("Pending claims of an invalid access"), Access.GetNumPendingClaims(), 0);
+
+    Access.EnqueueReturn(static_cast<AActor*>(nullptr));
+    Access.EnqueueReturn(FPooledActorHandle());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolAsyncAccessHeadroomTest, "LazyGenericDynamicObjectPool.Subsystems.AsyncAccess.Headroom",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolAsyncAccessHeadroomTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyObjectPoolAsyncAccessTests;
+
+    TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe> Counters;
+    TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe> Queues;
+    const FObjectPoolAsyncAccess Access = MakeAccess(2, Counters, Queues);
+    if (!TestTrue(TEXT("Access is valid"), Access.IsValid())) return false;
+
+    bool bCallbackRan = false;
+    TestTrue(TEXT("First claim"), Access.TryClaimActor(FTransform(FVector(1.0, 2.0, 3.0)), [&bCallbackRan](AActor*) { bCallbackRan = true; }));
+    TestTrue(TEXT("Second claim"), Access.TryClaimActor(FTransform::Identity, [](AActor*) {}));
+    TestFalse(TEXT("A claim past the headroom is turned down"), Access.TryClaimActor(FTransform::Identity, [](AActor*) {}));
+    TestEqual(TEXT("Pending claims"), Access.GetNumPendingClaims(), 2);
+
+    FLazyObjectPoolAsyncQueues::FAcquireRequest Acquire;
+    if (!TestTrue(TEXT("A claim is queued"), Queues->Acquires.Dequeue(Acquire))) return false;
+    TestEqual(TEXT("Pool index of the queued claim"), Acquire.PoolIndex, PoolIndex);
+    TestEqual(TEXT("Location of the queued claim"), Acquire.Transform.GetLocation(), FVector(1.0, 2.0, 3.0));
+    Acquire.OnAcquired(nullptr);
+    TestTrue(TEXT("The queued claim carries its callback"), bCallbackRan);
+
+    Counters->Headroom.store(0, std::memory_order_relaxed);
+    TestFalse(TEXT("A pool without headroom turns every claim down"), Access.TryClaimActor(FTransform::Identity, [](AActor*) {}));
+
+    Access.EnqueueReturn(FPooledActorHandle(PoolIndex, 0, 0));
+    FPooledActorHandle Returned;
+    TestTrue(TEXT("A handle return is queued"), Queues->HandleReturns.Dequeue(Returned));
+    TestTrue(TEXT("The queued handle return is the one enqueued"), Returned == FPooledActorHandle(PoolIndex, 0, 0));
+
+    Access.EnqueueReturn(FPooledActorHandle());
+    TestTrue(TEXT("An unset handle is not queued"), Queues->HandleReturns.IsEmpty());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolAsyncAccessConcurrentTest, "LazyGenericDynamicObjectPool.Subsystems.AsyncAccess.Concurrent",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolAsyncAccessConcurrentTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyObjectPoolAsyncAccessTests;
+
+    constexpr int32 Headroom = 1000;
+    constexpr int32 NumThreads = 16;
+    constexpr int32 ClaimsPerThread = 256;
+
+    TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe> Counters;
+    TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe> Queues;
+    const FObjectPoolAsyncAccess Access = MakeAccess(Headroom, Counters, Queues);
+
+    // More claims than headroom race from producer threads, exactly the headroom's worth has to go through.
+    std::atomic<int32> NumGranted { 0 };
+    RunProducers(NumThreads, [&Access, &NumGranted](int32)
+    {
+        for (int32 i = 0; i < ClaimsPerThread; ++i)
+        {
+            if (Access.TryClaimActor(FTransform::Identity, [](AActor*) {}))
+            {
+                NumGranted.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    TestEqual(TEXT("Claims granted"), NumGranted.load(), Headroom);
+    TestEqual(TEXT("Pending claims"), Access.GetNumPendingClaims(), Headroom);
+
+    int32 NumQueued = 0;
+    FLazyObjectPoolAsyncQueues::FAcquireRequest Acquire;
+    while (Queues->Acquires.Dequeue(Acquire))
+    {
+        NumQueued++;
+    }
+    TestEqual(TEXT("Claims queued"), NumQueued, Headroom);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolAsyncAccessSettleTest, "LazyGenericDynamicObjectPool.Subsystems.AsyncAccess.Settle",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolAsyncAccessSettleTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyObjectPoolAsyncAccessTests;
+
+    constexpr int32 NumThreads = 16;
+    constexpr int32 ClaimsPerThread = 4;
+    constexpr int32 NumClaims = NumThreads * ClaimsPerThread;
+
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    const FObjectPoolAsyncAccess Access = Subsystem->GetAsyncAccess(Subsystem->ResolvePoolId(ActorClass));
+    if (!TestTrue(TEXT("Access is valid"), Access.IsValid())) return false;
+
+    // Callbacks run on the game thread, so the results need no lock.
+    TArray<AActor*> Acquired;
+    int32 NumFailed = 0;
+    bool bCallbacksOnGameThread = true;
+    RunProducers(NumThreads, [&Access, &Acquired, &NumFailed, &bCallbacksOnGameThread](int32)
+    {
+        for (int32 i = 0; i < ClaimsPerThread; ++i)
+        {
+            Access.TryClaimActor(FTransform::Identity, [&Acquired, &NumFailed, &bCallbacksOnGameThread](AActor* Actor)
+            {
+                bCallbacksOnGameThread &= IsInGameThread();
+                if (Actor) Acquired.Add(Actor);
+                else NumFailed++;
+            });
+        }
+    });
+
+    TestEqual(TEXT("Pending claims before the async tick"), Access.GetNumPendingClaims(), NumClaims);
+    TestEqual(TEXT("Claims served before the async tick"), Acquired.Num(), 0);
+
+    // The world tick runs the subsystem's async tick function, which settles everything queued.
+    TestWorld.Tick();
+
+    TestTrue(TEXT("Claim callbacks ran on the game thread"), bCallbacksOnGameThread);
+    TestEqual(TEXT("Claims served"), Acquired.Num(), NumClaims);
+    TestEqual(TEXT("Claims failed"), NumFailed, 0);
+    TestEqual(TEXT("Pending claims after the async tick"), Access.GetNumPendingClaims(), 0);
+    TestEqual(TEXT("In-use actors after the claims"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), NumClaims);
+
+    // Half go back by pointer and half by handle, from the producer threads again.
+    TArray<FPooledActorHandle> Handles;
+    for (const AActor* Actor : Acquired)
+    {
+        Handles.Add(Subsystem->GetPooledActorHandle(Actor));
+    }
+    RunProducers(NumThreads, [&Access, &Acquired, &Handles](const int32 ThreadIndex)
+    {
+        for (int32 i = ThreadIndex * ClaimsPerThread; i < (ThreadIndex + 1) * ClaimsPerThread; ++i)
+        {
+            if (i % 2 == 0) Access.EnqueueReturn(Acquired[i]);
+            else Access.EnqueueReturn(Handles[i]);
+        }
+    });
+
+    TestEqual(TEXT("In-use actors before the returns are settled"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), NumClaims);
+    TestWorld.Tick();
+    TestEqual(TEXT("In-use actors after the returns are settled"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolAsyncAccessBenchmarkTest, "LazyGenericDynamicObjectPool.Subsystems.AsyncAccess.Benchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLazyObjectPoolAsyncAccessBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyObjectPoolAsyncAccessTests;
+
+    constexpr int32 OpsPerThread = 16384;
+
+    // Reports the average cost of one claim and return pair with the given number of producers hammering the same pool.
+    auto MeasureContention = [this](const int32 NumThreads)
+    {
+        TSharedPtr<FLazyObjectPoolAsyncCounters, ESPMode::ThreadSafe> Counters;
+        TSharedPtr<FLazyObjectPoolAsyncQueues, ESPMode::ThreadSafe> Queues;
+        const FObjectPoolAsyncAccess Access = MakeAccess(MAX_int32, Counters, Queues);
+
+        std::atomic<int32> NumGranted { 0 };
+        const double Elapsed = RunProducers(NumThreads, [&Access, &NumGranted](const int32 ThreadIndex)
+        {
+            int32 NumThreadGranted = 0;
+            for (int32 i = 0; i < OpsPerThread; ++i)
+            {
+                NumThreadGranted += Access.TryClaimActor(FTransform::Identity, [](AActor*) {}) ? 1 : 0;
+                Access.EnqueueReturn(FPooledActorHandle(PoolIndex, ThreadIndex, i));
+            }
+            NumGranted.fetch_add(NumThreadGranted, std::memory_order_relaxed);
+        });
+
+        const double NumOps = double(NumThreads) * OpsPerThread;
+        TestEqual(FString::Printf(TEXT("%d producers: claims granted"), NumThreads), NumGranted.load(), NumThreads * OpsPerThread);
+        AddInfo(FString::Printf(TEXT("%d producers: %.1f ns per claim and return overall, %.1f ns per claim and return on each producer"),
+            NumThreads, Elapsed * 1.0e9 / NumOps, Elapsed * 1.0e9 / OpsPerThread));
+    };
+
+    MeasureContention(1);
+    MeasureContention(16);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
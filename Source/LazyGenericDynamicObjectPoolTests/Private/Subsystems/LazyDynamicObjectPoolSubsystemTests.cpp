@@ -0,0 +1,450 @@
+// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#include "Subsystems/LazyDynamicObjectPoolSubsystem.h"
+#include "DeveloperSettings/LazyDynamicObjectPoolSettings.h"
+#include "Components/PrimitiveComponent.h"
+#include "LazyObjectPoolTestActor.h"
+#include "LazyObjectPoolTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace LazyDynamicObjectPoolSubsystemTests
+{
+    // Fills the pool with NumActors idle actors, so benchmarks time reuse rather than spawning.
+    void Prewarm(ULazyDynamicObjectPoolSubsystem& Subsystem, const TSubclassOf<AActor> ActorClass, const int32 NumActors)
+    {
+        TArray<AActor*> Actors;
+        for (int32 i = 0; i < NumActors; ++i)
+        {
+            Actors.Add(Subsystem.GetActorFromHandle(Subsystem.AcquireActorFromPool(ActorClass, FTransform::Identity)));
+        }
+        Subsystem.ReturnActorsToPool(Actors);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolReturnReentryTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.ReturnReentry",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolReturnReentryTest::RunTest(const FString& Parameters)
+{
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    const FPooledActorHandle Handle = Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity);
+    ALazyObjectPoolTestActor* Actor = Cast<ALazyObjectPoolTestActor>(Subsystem->GetActorFromHandle(Handle));
+    if (!TestNotNull(TEXT("Acquired actor"), Actor)) return false;
+
+    // Returning the actor again from its own deactivation must neither recurse nor count it twice.
+    Actor->OnDeactivated = [Subsystem](ALazyObjectPoolTestActor* Self)
+    {
+        Subsystem->ReturnActorToPool(Self);
+    };
+    Subsystem->ReturnActorToPool(Actor);
+
+    TestEqual(TEXT("Deactivations"), Actor->NumDeactivations, 1);
+    TestFalse(TEXT("The handle went stale"), Subsystem->IsPooledActorHandleValid(Handle));
+    TestEqual(TEXT("In-use actors"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), 0);
+    TestEqual(TEXT("Times the actor is available"), Subsystem->GetAvailableActorsInPool(ActorClass).FilterByPredicate(
+        [Actor](const AActor* Available) { return Available == Actor; }).Num(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolBatchReturnReentryTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.BatchReturnReentry",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolBatchReturnReentryTest::RunTest(const FString& Parameters)
+{
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    ALazyObjectPoolTestActor* First = Cast<ALazyObjectPoolTestActor>(Subsystem->GetActorFromHandle(Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity)));
+    ALazyObjectPoolTestActor* Second = Cast<ALazyObjectPoolTestActor>(Subsystem->GetActorFromHandle(Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity)));
+    if (!TestNotNull(TEXT("First actor"), First) || !TestNotNull(TEXT("Second actor"), Second)) return false;
+
+    // Whichever is deactivated first returns both batch members on its own.
+    auto ReturnBoth = [Subsystem, First, Second](ALazyObjectPoolTestActor*)
+    {
+        Subsystem->ReturnActorToPool(First);
+        Subsystem->ReturnActorToPool(Second);
+    };
+    First->OnDeactivated = ReturnBoth;
+    Second->OnDeactivated = ReturnBoth;
+
+    const TArray<AActor*> Batch = { First, Second };
+    Subsystem->ReturnActorsToPool(Batch);
+
+    TestEqual(TEXT("Deactivations of the first actor"), First->NumDeactivations, 1);
+    TestEqual(TEXT("Deactivations of the second actor"), Second->NumDeactivations, 1);
+    TestEqual(TEXT("In-use actors"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), 0);
+    TestEqual(TEXT("Available actors"), Subsystem->GetAvailableActorsInPool(ActorClass).Num(), Subsystem->GetPoolSize(ActorClass));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolReturnReacquireTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.ReturnReacquire",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolReturnReacquireTest::RunTest(const FString& Parameters)
+{
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    ALazyObjectPoolTestActor* Actor = Cast<ALazyObjectPoolTestActor>(Subsystem->GetActorFromHandle(Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity)));
+    if (!TestNotNull(TEXT("Acquired actor"), Actor)) return false;
+
+    // Destroying the actor releases its slot, the acquire right after may put a new actor in that same slot.
+    FPooledActorHandle ReacquiredHandle;
+    Actor->OnDeactivated = [Subsystem, ActorClass, &ReacquiredHandle](ALazyObjectPoolTestActor* Self)
+    {
+        Self->Destroy();
+        ReacquiredHandle = Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity);
+    };
+    Subsystem->ReturnActorToPool(Actor);
+
+    TestTrue(TEXT("The actor acquired during the return stays acquired"), Subsystem->IsPooledActorHandleValid(ReacquiredHandle));
+    TestEqual(TEXT("In-use actors"), Subsystem->GetInUseActorsInPool(ActorClass).Num(), 1);
+
+    const ALazyObjectPoolTestActor* Reacquired = Cast<ALazyObjectPoolTestActor>(Subsystem->GetActorFromHandle(ReacquiredHandle));
+    if (TestNotNull(TEXT("Reacquired actor"), Reacquired))
+    {
+        TestEqual(TEXT("Deactivations of the reacquired actor"), Reacquired->NumDeactivations, 0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolCancelFutureTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.CancelFuture",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolCancelFutureTest::RunTest(const FString& Parameters)
+{
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    // Requests are only served from the tick, so this one is still pending when it is cancelled.
+    const FPooledActorFuture Pending = Subsystem->AcquireActorFromPoolFuture(ALazyObjectPoolTestActor::StaticClass(), FTransform::Identity);
+    if (!TestTrue(TEXT("The request is queued"), Pending.RequestId != INDEX_NONE)) return false;
+    TestFalse(TEXT("A pending future is not set"), Pending.Future.IsReady());
+
+    TestTrue(TEXT("Cancelling a pending request"), Subsystem->CancelAsyncAcquire(Pending.RequestId));
+    TestTrue(TEXT("A cancelled future is set"), Pending.Future.IsReady());
+    TestNull(TEXT("A cancelled future holds no actor"), Pending.Future.Get());
+    TestFalse(TEXT("Cancelling the same request twice"), Subsystem->CancelAsyncAcquire(Pending.RequestId));
+
+    const FPooledActorFuture Served = Subsystem->AcquireActorFromPoolFuture(ALazyObjectPoolTestActor::StaticClass(), FTransform::Identity);
+
+    // Budgeted growth may take a few frames to spawn the actor.
+    for (int32 Frame = 0; Frame < 10 && !Served.Future.IsReady(); ++Frame)
+    {
+        TestWorld.Tick();
+    }
+    TestTrue(TEXT("A served future is set"), Served.Future.IsReady());
+    TestNotNull(TEXT("A served future holds the actor"), Served.Future.Get());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolClearAbandonsRequestsTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.ClearAbandonsRequests",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLazyObjectPoolClearAbandonsRequestsTest::RunTest(const FString& Parameters)
+{
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const FPooledActorFuture Pending = Subsystem->AcquireActorFromPoolFuture(ALazyObjectPoolTestActor::StaticClass(), FTransform::Identity);
+    if (!TestTrue(TEXT("The request is queued"), Pending.RequestId != INDEX_NONE)) return false;
+
+    Subsystem->ClearAllPools();
+    TestEqual(TEXT("Pending requests after clearing"), Subsystem->GetNumPendingAsyncAcquires(), 0);
+    TestTrue(TEXT("An abandoned future is set"), Pending.Future.IsReady());
+    TestNull(TEXT("An abandoned future holds no actor"), Pending.Future.Get());
+
+    // Nothing is served into the rebuilt pool on the next frames.
+    TestWorld.Tick();
+    TestEqual(TEXT("In-use actors after clearing"), Subsystem->GetInUseActorsInPool(ALazyObjectPoolTestActor::StaticClass()).Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolTypedAcquireBenchmarkTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.TypedAcquireBenchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLazyObjectPoolTypedAcquireBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyDynamicObjectPoolSubsystemTests;
+
+    constexpr int32 NumActors = 256;
+    constexpr int32 NumRounds = 64;
+
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    Prewarm(*Subsystem, ActorClass, NumActors);
+
+    // Reports the average cost of one acquisition, the returns in between are not timed.
+    auto MeasureAcquire = [this, Subsystem](const TCHAR* Name, const TFunctionRef<ALazyObjectPoolTestActor*()> Acquire)
+    {
+        TArray<AActor*> Actors;
+        Actors.Reserve(NumActors);
+
+        double Elapsed = 0.0;
+        for (int32 Round = 0; Round < NumRounds; ++Round)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 i = 0; i < NumActors; ++i)
+            {
+                Actors.Add(Acquire());
+            }
+            Elapsed += FPlatformTime::Seconds() - StartTime;
+
+            TestEqual(FString::Printf(TEXT("%s acquisitions that got an actor"), Name), Actors.FilterByPredicate(
+                [](const AActor* Actor) { return Actor != nullptr; }).Num(), NumActors);
+            Subsystem->ReturnActorsToPool(Actors);
+            Actors.Reset();
+        }
+
+        AddInfo(FString::Printf(TEXT("%s: %.1f ns per acquire"), Name, Elapsed * 1.0e9 / (double(NumActors) * NumRounds)));
+    };
+
+    MeasureAcquire(TEXT("Class lookup"), [Subsystem, ActorClass]()
+    {
+        AActor* Actor = Subsystem->InitializeActorFromPool(ActorClass, nullptr);
+        return Cast<ALazyObjectPoolTestActor>(Subsystem->FinishInitializeActorFromPool(Actor, FTransform::Identity));
+    });
+
+    const TPoolRef<ALazyObjectPoolTestActor> PoolRef = Subsystem->ResolvePool<ALazyObjectPoolTestActor>();
+    MeasureAcquire(TEXT("Typed pool id"), [Subsystem, &PoolRef]()
+    {
+        return Subsystem->AcquireTyped(PoolRef, FTransform::Identity);
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolBatchReturnBenchmarkTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.BatchReturnBenchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLazyObjectPoolBatchReturnBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace LazyDynamicObjectPoolSubsystemTests;
+
+    constexpr int32 NumActors = 512;
+    constexpr int32 NumRounds = 32;
+
+    const FLazyObjectPoolTestWorld TestWorld;
+    ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+    if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return false;
+
+    const TSubclassOf<AActor> ActorClass = ALazyObjectPoolTestActor::StaticClass();
+    Prewarm(*Subsystem, ActorClass, NumActors);
+
+    // Reports the average cost of returning one actor of a wave, the acquisitions in between are not timed.
+    auto MeasureReturn = [this, Subsystem, ActorClass](const TCHAR* Name, const TFunctionRef<void(TArrayView<AActor* const>)> Return)
+    {
+        TArray<AActor*> Actors;
+        Actors.Reserve(NumActors);
+
+        double Elapsed = 0.0;
+        for (int32 Round = 0; Round < NumRounds; ++Round)
+        {
+            for (int32 i = 0; i < NumActors; ++i)
+            {
+                Actors.Add(Subsystem->GetActorFromHandle(Subsystem->AcquireActorFromPool(ActorClass, FTransform::Identity)));
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            Return(Actors);
+            Elapsed += FPlatformTime::Seconds() - StartTime;
+
+            TestEqual(FString::Printf(TEXT("%s in-use actors after the return"), Name), Subsystem->GetInUseActorsInPool(ActorClass).Num(), 0);
+            Actors.Reset();
+        }
+
+        AddInfo(FString::Printf(TEXT("%s: %.1f ns per actor returned"), Name, Elapsed * 1.0e9 / (double(NumActors) * NumRounds)));
+    };
+
+    MeasureReturn(TEXT("Single returns"), [Subsystem](const TArrayView<AActor* const> Actors)
+    {
+        for (AActor* Actor : Actors)
+        {
+            Subsystem->ReturnActorToPool(Actor);
+        }
+    });
+
+    MeasureReturn(TEXT("Batch return"), [Subsystem](const TArrayView<AActor* const> Actors)
+    {
+        Subsystem->ReturnActorsToPool(Actors);
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolActivationPlanBenchmarkTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.ActivationPlanBenchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLazyObjectPoolActivationPlanBenchmarkTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumActors = 128;
+    constexpr int32 NumRounds = 64;
+
+    const FLazyObjectPoolTestWorld TestWorld;
+    TArray<ALazyObjectPoolHeavyTestActor*> Actors;
+    for (int32 i = 0; i < NumActors; ++i)
+    {
+        Actors.Add(TestWorld.GetWorld()->SpawnActor<ALazyObjectPoolHeavyTestActor>());
+    }
+    TestEqual(TEXT("Components per actor"), Actors[0]->GetComponents().Num(), ALazyObjectPoolHeavyTestActor::NumSceneComponents + 1);
+
+    // Reports the average cost of activating and deactivating one actor.
+    auto MeasureCycle = [this, &Actors](const TCHAR* Name, const TFunctionRef<void(int32, bool)> SetActive)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Round = 0; Round < NumRounds; ++Round)
+        {
+            for (int32 i = 0; i < NumActors; ++i)
+            {
+                SetActive(i, true);
+                SetActive(i, false);
+            }
+        }
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        TestTrue(FString::Printf(TEXT("%s leaves the actors hidden"), Name), Actors.Last()->IsHidden());
+        AddInfo(FString::Printf(TEXT("%s: %.1f ns per activation and deactivation"), Name, Elapsed * 1.0e9 / (double(NumActors) * NumRounds)));
+    };
+
+    // What ActivateActor and DeactivateActor did before the plan: a reflection check and a component gather on every call,
+    // with collision and tick switched whether the class has them or not.
+    MeasureCycle(TEXT("Uncached plan"), [&Actors](const int32 ActorIndex, const bool bActive)
+    {
+        AActor* Actor = Actors[ActorIndex];
+        Actor->SetActorHiddenInGame(!bActive);
+        Actor->SetActorEnableCollision(bActive);
+        Actor->SetActorTickEnabled(bActive);
+        if (Actor->Implements<UPoolableActorInterface>()) return;
+
+        TInlineComponentArray<UActorComponent*> Components;
+        Actor->GetComponents(Components);
+        for (UActorComponent* Component : Components)
+        {
+            if (!IsValid(Component)) continue;
+
+            if (bActive) Component->Activate(true);
+            else Component->Deactivate();
+        }
+    });
+
+    // The same with the plan built once from the class default and the components gathered once per actor and held weakly,
+    // the way the subsystem caches them per class and per slot.
+    const ALazyObjectPoolHeavyTestActor* DefaultActor = GetDefault<ALazyObjectPoolHeavyTestActor>();
+    const bool bImplementsInterface = ALazyObjectPoolHeavyTestActor::StaticClass()->ImplementsInterface(UPoolableActorInterface::StaticClass());
+    const bool bToggleCollision = DefaultActor->GetActorEnableCollision();
+    const bool bToggleTick = DefaultActor->PrimaryActorTick.bCanEverTick;
+
+    TArray<TArray<TWeakObjectPtr<UActorComponent>>> SlotComponents;
+    for (const AActor* Actor : Actors)
+    {
+        SlotComponents.Emplace(Actor->GetComponents().Array());
+    }
+
+    MeasureCycle(TEXT("Cached plan"), [&Actors, &SlotComponents, bImplementsInterface, bToggleCollision, bToggleTick](const int32 ActorIndex, const bool bActive)
+    {
+        AActor* Actor = Actors[ActorIndex];
+        Actor->SetActorHiddenInGame(!bActive);
+        if (bToggleCollision) Actor->SetActorEnableCollision(bActive);
+        if (bToggleTick) Actor->SetActorTickEnabled(bActive);
+        if (bImplementsInterface) return;
+
+        for (const TWeakObjectPtr<UActorComponent>& WeakComponent : SlotComponents[ActorIndex])
+        {
+            UActorComponent* Component = WeakComponent.Get();
+            if (!IsValid(Component)) continue;
+
+            if (bActive) Component->Activate(true);
+            else Component->Deactivate();
+        }
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLazyObjectPoolParkingBenchmarkTest, "LazyGenericDynamicObjectPool.Subsystems.Subsystem.ParkingBenchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLazyObjectPoolParkingBenchmarkTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumActors = 256;
+    constexpr int32 NumFrames = 32;
+    constexpr double GameplayRadius = 10000.0;
+
+    // Pools take their parking mode from the settings when they are created, so each mode gets its own world.
+    ULazyDynamicObjectPoolSettings* Settings = GetMutableDefault<ULazyDynamicObjectPoolSettings>();
+    const EPooledActorParkingMode OriginalParkingMode = Settings->ParkingMode;
+
+    // Reports how many idle primitives are left in the render scene, the physics scene and the gameplay area, and what a frame costs.
+    auto MeasureParking = [this, Settings](const EPooledActorParkingMode ParkingMode, const TCHAR* Name)
+    {
+        Settings->ParkingMode = ParkingMode;
+        const FLazyObjectPoolTestWorld TestWorld;
+        ULazyDynamicObjectPoolSubsystem* Subsystem = TestWorld.GetSubsystem();
+        if (!TestNotNull(TEXT("Subsystem"), Subsystem)) return;
+
+        // Returned where they were used, spread over a few metres around the origin.
+        const TSubclassOf<AActor> ActorClass = ALazyObjectPoolHeavyTestActor::StaticClass();
+        TArray<AActor*> Actors;
+        for (int32 i = 0; i < NumActors; ++i)
+        {
+            const FVector Location((i % 16) * 200.0, (i / 16) * 200.0, 100.0);
+            Actors.Add(Subsystem->GetActorFromHandle(Subsystem->AcquireActorFromPool(ActorClass, FTransform(Location))));
+        }
+        Subsystem->ReturnActorsToPool(Actors);
+
+        int32 NumRendered = 0;
+        int32 NumInPhysics = 0;
+        int32 NumInGameplayArea = 0;
+        const TArray<AActor*> IdleActors = Subsystem->GetAvailableActorsInPool(ActorClass);
+        for (const AActor* Actor : IdleActors)
+        {
+            TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+            for (const UPrimitiveComponent* Primitive : Primitives)
+            {
+                NumRendered += Primitive->IsRenderStateCreated() ? 1 : 0;
+                NumInPhysics += Primitive->IsPhysicsStateCreated() ? 1 : 0;
+                NumInGameplayArea += Primitive->IsRegistered() && Primitive->GetComponentLocation().Size() < GameplayRadius ? 1 : 0;
+            }
+        }
+        TestEqual(FString::Printf(TEXT("%s idle actors"), Name), IdleActors.Num(), Subsystem->GetPoolSize(ActorClass));
+
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            TestWorld.Tick();
+        }
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        AddInfo(FString::Printf(TEXT("%s: %d idle primitives rendered, %d in the physics scene, %d in the gameplay area, %.3f ms per frame"),
+            Name, NumRendered, NumInPhysics, NumInGameplayArea, Elapsed * 1000.0 / NumFrames));
+    };
+
+    MeasureParking(EPooledActorParkingMode::None, TEXT("Unparked"));
+    MeasureParking(EPooledActorParkingMode::Isolated, TEXT("Isolated"));
+    MeasureParking(EPooledActorParkingMode::Unregistered, TEXT("Unregistered"));
+
+    Settings->ParkingMode = OriginalParkingMode;
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
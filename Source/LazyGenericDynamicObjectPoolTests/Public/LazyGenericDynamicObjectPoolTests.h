@@ -0,0 +1,16 @@
+﻿// Copyright (C) 2024 Job Omondiale - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/** Hosts the automation tests of the pool, run them with "Automation RunTests LazyGenericDynamicObjectPool". */
+class FLazyGenericDynamicObjectPoolTestsModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};